@@ -76,20 +76,19 @@ namespace pine
 
 		/**
 		 * Maximum memory used by an IPC message request.
-		 * Equivalent to 50,000 Write64 requests.
+		 * Allows a 4MiB MsgWriteRange request.
 		 */
-		#define MAX_IPC_SIZE 650000
+		#define MAX_IPC_SIZE 0x410000
 
 		/**
 		 * Maximum memory used by an IPC message reply.
-		 * Equivalent to 50,000 Read64 replies.
+		 * Allows a 4MiB MsgReadRange reply.
 		 */
-		#define MAX_IPC_RETURN_SIZE 450000
+		#define MAX_IPC_RETURN_SIZE 0x410000
 
 		/**
 		 * IPC return buffer.
 		 * A preallocated buffer used to store all IPC replies.
-		 * to the size of 50.000 MsgWrite64 IPC calls.
 		 */
 		std::vector<char> m_ret_buffer;
 
@@ -121,6 +120,10 @@ namespace pine
 			MsgUUID = 0xD,          /**< Returns the game UUID. */
 			MsgGameVersion = 0xE,   /**< Returns the game verion. */
 			MsgStatus = 0xF,        /**< Returns the emulator status. */
+			MsgReadRange = 0x20,    /**< Read a contiguous memory range. */
+			MsgWriteRange = 0x21,   /**< Write a contiguous memory range. */
+			MsgSharedMemory = 0x22, /**< Returns the location of the shared main memory mapping. */
+			MsgWaitFlip = 0x23,     /**< Waits for the next emulated flip. */
 			MsgUnimplemented = 0xFF /**< Unimplemented IPC message. */
 		};
 
@@ -291,6 +294,65 @@ namespace pine
 					buf_cnt += 12;
 					break;
 				}
+				case MsgReadRange:
+				{
+					// format: XX AA AA AA AA SS SS SS SS, reply: data of size SS
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+						return error();
+					const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, size, buf_size))
+						return error();
+					if (!Impl::read_range(a, size, &ret_buffer[ret_cnt]))
+						return error();
+					ret_cnt += size;
+					buf_cnt += 8;
+					break;
+				}
+				case MsgWriteRange:
+				{
+					// format: XX AA AA AA AA SS SS SS SS followed by data of size SS
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, 0, buf_size))
+						return error();
+					const u32 a = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 size = FromArray<u32>(&buf[buf_cnt], 4);
+					if (!SafetyChecks(buf_cnt, 8 + usz{size}, ret_cnt, 0, buf_size))
+						return error();
+					if (!Impl::write_range(a, size, &buf[buf_cnt + 8]))
+						return error();
+					buf_cnt += 8 + usz{size};
+					break;
+				}
+				case MsgSharedMemory:
+				{
+					// reply: guest address (4 bytes), size (4 bytes), path string
+					// The path can be mapped read-only to sample main memory without further IPC calls
+					if (!SafetyChecks(buf_cnt, 0, ret_cnt, 8, buf_size))
+						return error();
+					u32 addr = 0, size = 0;
+					const std::string path = Impl::get_shared_memory(addr, size);
+					if (path.empty())
+						return error();
+					ToArray(ret_buffer, addr, ret_cnt);
+					ToArray(ret_buffer, size, ret_cnt + 4);
+					ret_cnt += 8;
+					if (!write_string(path))
+						return error();
+					break;
+				}
+				case MsgWaitFlip:
+				{
+					// format: XX FF FF FF FF TT TT TT TT (last seen flip count, timeout in ms)
+					// reply: current flip count, equal to the argument on timeout
+					if (!SafetyChecks(buf_cnt, 8, ret_cnt, 4, buf_size))
+						return error();
+					const u32 last_flip = FromArray<u32>(&buf[buf_cnt], 0);
+					const u32 timeout = FromArray<u32>(&buf[buf_cnt], 4);
+					ToArray(ret_buffer, Impl::wait_flip(last_flip, timeout), ret_cnt);
+					ret_cnt += 4;
+					buf_cnt += 8;
+					break;
+				}
 				case MsgVersion:
 				{
 					if (!write_string("RPCS3 " + Impl::get_version_and_branch()))
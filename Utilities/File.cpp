@@ -239,6 +239,13 @@ namespace fs
 		// Do notning
 	}
 
+	u64 file_base::write_at(u64, const void*, u64)
+	{
+		// Not supported by default
+		g_tls_error = error::inval;
+		return 0;
+	}
+
 	fs::native_handle fs::file_base::get_handle()
 	{
 #ifdef _WIN32
@@ -540,6 +547,35 @@ namespace fs
 			return nwritten_sum;
 		}
 
+		u64 write_at(u64 offset, const void* buffer, u64 count) override
+		{
+			u64 nwritten_sum = 0;
+
+			for (const char* data = static_cast<const char*>(buffer); count;)
+			{
+				const DWORD size = static_cast<DWORD>(std::min<u64>(count, DWORD{umax} & -4096));
+
+				DWORD nwritten = 0;
+				OVERLAPPED ovl{};
+				ovl.Offset = DWORD(offset);
+				ovl.OffsetHigh = DWORD(offset >> 32);
+				ensure(WriteFile(m_handle, data, size, &nwritten, &ovl)); // "file::write_at"
+				ensure(nwritten == size);
+				nwritten_sum += nwritten;
+
+				if (nwritten < size)
+				{
+					break;
+				}
+
+				count -= size;
+				data += size;
+				offset += size;
+			}
+
+			return nwritten_sum;
+		}
+
 		u64 seek(s64 offset, seek_mode whence) override
 		{
 			if (whence > seek_end)
@@ -712,6 +748,25 @@ namespace fs
 			return result;
 		}
 
+		u64 write_at(u64 offset, const void* buffer, u64 count) override
+		{
+			u64 result = 0;
+
+			// For safety; see read()
+			while (auto r = ::pwrite(m_fd, buffer, count, offset))
+			{
+				ensure(r > 0); // "file::write_at"
+				count -= r;
+				offset += r;
+				result += r;
+				buffer = static_cast<const u8*>(buffer) + r;
+				if (!count)
+					break;
+			}
+
+			return result;
+		}
+
 		u64 seek(s64 offset, seek_mode whence) override
 		{
 			if (whence > seek_end)
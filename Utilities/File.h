@@ -109,6 +109,7 @@ namespace fs
 		virtual u64 read(void* buffer, u64 size) = 0;
 		virtual u64 read_at(u64 offset, void* buffer, u64 size) = 0;
 		virtual u64 write(const void* buffer, u64 size) = 0;
+		virtual u64 write_at(u64 offset, const void* buffer, u64 size);
 		virtual u64 seek(s64 offset, seek_mode whence) = 0;
 		virtual u64 size() = 0;
 		virtual native_handle get_handle();
@@ -348,6 +349,13 @@ namespace fs
 			return m_file->write(buffer, count);
 		}
 
+		// Write the data to the file at specified offset in thread-safe manner (doesn't change current position)
+		u64 write_at(u64 offset, const void* buffer, u64 count, std::source_location src_loc = std::source_location::current()) const
+		{
+			if (!m_file) xnull(src_loc);
+			return m_file->write_at(offset, buffer, count);
+		}
+
 		// Change current position, returns resulting position
 		u64 seek(s64 offset, seek_mode whence = seek_set, std::source_location src_loc = std::source_location::current()) const
 		{
@@ -546,14 +546,14 @@ public:
 	// Add module (not cached)
 	void add(std::unique_ptr<llvm::Module> _module);
 
-	// Add object (path to obj file)
-	bool add(const std::string& path);
+	// Add object (path to obj file, optional shared store directory of decompressed objects)
+	bool add(const std::string& path, const std::string& shared_store = {});
 
 	// Update global mapping for a single value
 	void update_global_mapping(const std::string& name, u64 addr);
 
-	// Check object file
-	static bool check(const std::string& path);
+	// Check object file (optional shared store directory of decompressed objects)
+	static bool check(const std::string& path, const std::string& shared_store = {});
 
 	// Finalize
 	void fin();
@@ -40,6 +40,7 @@ LOG_CHANNEL(jit_log, "JIT");
 #include "llvm/ExecutionEngine/JITEventListener.h"
 #include "llvm/Object/ObjectFile.h"
 #include "llvm/Object/SymbolSize.h"
+#include "llvm/Support/MemoryBuffer.h"
 #ifdef _MSC_VER
 #pragma warning(pop)
 #else
@@ -494,6 +495,53 @@ public:
 		return nullptr;
 	}
 
+	// Load decompressed object from the shared store, which is content-addressed by object file names (hashes of code and settings)
+	// Objects are mapped read-only, so processes using the same store share their memory through the page cache
+	static std::unique_ptr<llvm::MemoryBuffer> load_shared(const std::string& path, const std::string& store)
+	{
+		const std::string name = store + path.substr(path.find_last_of('/') + 1);
+
+		if (fs::is_file(name))
+		{
+			if (auto buf = llvm::MemoryBuffer::getFile(name, false, false, false))
+			{
+				return std::move(*buf);
+			}
+
+			jit_log.error("LLVM: Failed to map shared module: '%s'", name);
+		}
+
+		auto buf = load(path);
+
+		if (!buf)
+		{
+			return nullptr;
+		}
+
+		// Publish the object for other processes, one writer at a time
+		if (fs::file lock{name + ".lock", fs::write + fs::create + fs::lock})
+		{
+			if (!fs::is_file(name))
+			{
+				fs::pending_file file(name);
+
+				if (file.file && file.file.write(buf->getBufferStart(), buf->getBufferSize()) == buf->getBufferSize() && file.commit())
+				{
+					jit_log.notice("LLVM: Added module to the shared store: %s", name);
+				}
+				else
+				{
+					jit_log.error("LLVM: Failed to add module to the shared store: %s (%s)", name, fs::g_tls_error);
+				}
+			}
+
+			// Remove the lock file while still holding it, a late writer will find the object published
+			fs::remove_file(name + ".lock");
+		}
+
+		return buf;
+	}
+
 	std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* _module) override
 	{
 		std::string path = m_path;
@@ -801,9 +849,9 @@ void jit_compiler::add(std::unique_ptr<llvm::Module> _module)
 	}
 }
 
-bool jit_compiler::add(const std::string& path)
+bool jit_compiler::add(const std::string& path, const std::string& shared_store)
 {
-	auto cache = ObjectCache::load(path);
+	auto cache = shared_store.empty() ? ObjectCache::load(path) : ObjectCache::load_shared(path, shared_store);
 
 	if (!cache)
 	{
@@ -824,8 +872,20 @@ bool jit_compiler::add(const std::string& path)
 	}
 }
 
-bool jit_compiler::check(const std::string& path)
+bool jit_compiler::check(const std::string& path, const std::string& shared_store)
 {
+	if (!shared_store.empty())
+	{
+		// Objects in the store may exist without the local cache file
+		if (auto buf = llvm::MemoryBuffer::getFile(shared_store + path.substr(path.find_last_of('/') + 1), false, false, false))
+		{
+			if (auto object_file = llvm::object::ObjectFile::createObjectFile(**buf))
+			{
+				return true;
+			}
+		}
+	}
+
 	if (auto cache = ObjectCache::load(path))
 	{
 		if (auto object_file = llvm::object::ObjectFile::createObjectFile(*cache))
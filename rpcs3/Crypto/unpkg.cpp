@@ -6,17 +6,21 @@
 #include "Utilities/StrUtil.h"
 #include "Utilities/Thread.h"
 #include "Emu/System.h"
+#include "Emu/system_config.h"
 #include "Emu/system_utils.hpp"
 #include "Emu/VFS.h"
 #include "unpkg.h"
 #include "util/sysinfo.hpp"
+#include "util/asm.hpp"
 #include "Loader/PSF.h"
 
 #include <filesystem>
+#include <numeric>
+#include <thread>
 
 LOG_CHANNEL(pkg_log, "PKG");
 
-package_reader::package_reader(const std::string& path, fs::file file)
+package_reader::package_reader(const std::string& path, fs::file file, bool streaming, u32 stream_timeout)
 	: m_path(path)
 	, m_file(std::move(file))
 {
@@ -26,6 +30,13 @@ package_reader::package_reader(const std::string& path, fs::file file)
 		return;
 	}
 
+	if (streaming)
+	{
+		auto stream = std::make_unique<pkg_stream>(std::move(m_file), stream_timeout);
+		m_stream = stream.get();
+		m_file.reset(std::move(stream));
+	}
+
 	m_is_valid = read_header();
 
 	if (!m_is_valid)
@@ -49,7 +60,12 @@ package_reader::package_reader(const std::string& path, fs::file file)
 
 	const bool param_sfo_found = read_param_sfo();
 
-	if (!param_sfo_found)
+	if (!param_sfo_found && m_stream)
+	{
+		// PARAM.SFO must be found within the data which can be retained before installation
+		pkg_log.error("PKG stream: PARAM.SFO could not be read, version and compatibility checks are skipped");
+	}
+	else if (!param_sfo_found)
 	{
 		pkg_log.notice("PKG does not contain a PARAM.SFO");
 	}
@@ -946,10 +962,199 @@ bool package_reader::fill_data(std::map<std::string, install_entry*>& all_instal
 	return true;
 }
 
+// Entry types which are written as-is after PKG decryption (see extract_worker)
+static bool is_raw_file_entry(u8 entry_type)
+{
+	switch (entry_type)
+	{
+	case PKG_FILE_ENTRY_NPDRM:
+	case PKG_FILE_ENTRY_NPDRMEDAT:
+	case PKG_FILE_ENTRY_REGULAR:
+	case PKG_FILE_ENTRY_UNK0:
+	case PKG_FILE_ENTRY_UNK1:
+	case 0xe:
+	case 0x10:
+	case 0x11:
+	case 0x13:
+	case 0x14:
+	case 0x15:
+	case 0x16:
+	case 0x18:
+	case 0x19:
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool package_reader::prepare_split_entries(usz thread_count)
+{
+	m_install_splits.clear();
+	m_install_ranges.clear();
+	m_range_indexer = 0;
+
+	if (thread_count <= 1)
+	{
+		return true;
+	}
+
+	const bool presize = g_cfg.vfs.pkg_presize.get();
+
+	for (install_entry& entry : m_install_entries)
+	{
+		if (entry.file_size < SPLIT_THRESHOLD || !entry.is_dominating() || !is_raw_file_entry(entry.type & 0xff))
+		{
+			continue;
+		}
+
+		const std::string& path = entry.weak_reference->first;
+		const bool did_overwrite = fs::is_file(path);
+
+		if (did_overwrite && !(entry.type & PKG_FILE_ENTRY_OVERWRITE))
+		{
+			// Let extract_worker handle it
+			continue;
+		}
+
+		// Only create the file here, it is opened when its first range is written (see extract_range_worker)
+		fs::file out{ path, did_overwrite ? fs::rewrite : fs::write_new };
+
+		if (!out)
+		{
+			pkg_log.error("Failed to create file %s (did_overwrite=%d, error=%s)", path, did_overwrite, fs::g_tls_error);
+			return false;
+		}
+
+		// Set the final size so positional writes from all workers don't keep extending the file (the file is sparse)
+		if (presize && !out.trunc(entry.file_size))
+		{
+			pkg_log.warning("Failed to presize file %s (size=0x%x, error=%s)", path, entry.file_size, fs::g_tls_error);
+		}
+
+		out.close();
+
+		const usz split_index = m_install_splits.size();
+
+		install_split& split = m_install_splits.emplace_back();
+		split.entry = &entry;
+		split.did_overwrite = did_overwrite;
+		split.ranges_left = utils::aligned_div<u64>(entry.file_size, BUF_SIZE);
+
+		// The keystream is seekable, so every range can be decrypted independently
+		for (u64 offset = 0; offset < entry.file_size; offset += BUF_SIZE)
+		{
+			m_install_ranges.push_back({
+				.split_index = split_index,
+				.offset = offset,
+				.size = std::min<u64>(BUF_SIZE, entry.file_size - offset)
+			});
+		}
+
+		entry.is_split = true;
+
+		pkg_log.notice("Entry: type=0x%08x, name='%s' (split into %u ranges)", entry.type, entry.name, split.ranges_left.load());
+	}
+
+	return true;
+}
+
+void package_reader::extract_range_worker()
+{
+	std::vector<u8> buffer;
+
+	while (m_num_failures == 0 && !m_aborted)
+	{
+		// Make sure m_range_indexer does not exceed m_install_ranges
+		const usz index = m_range_indexer.fetch_op([this](usz& v)
+		{
+			if (v < m_install_ranges.size())
+			{
+				v++;
+				return true;
+			}
+
+			return false;
+		}).first;
+
+		if (index >= m_install_ranges.size())
+		{
+			break;
+		}
+
+		const install_range& range = ::at32(m_install_ranges, index);
+		install_split& split = ::at32(m_install_splits, range.split_index);
+		const install_entry& entry = *split.entry;
+		const std::string& path = entry.weak_reference->first;
+
+		const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
+
+		buffer.resize(range.size + BUF_PADDING);
+
+		if (decrypt(entry.file_offset + range.offset, range.size, is_psp ? PKG_AES_KEY2 : m_dec_key.data(), buffer.data()) != range.size)
+		{
+			m_num_failures++;
+			pkg_log.error("Failed to read file %s (offset=0x%x, size=0x%x)", path, range.offset, range.size);
+			break;
+		}
+
+		{
+			// Ranges are queued entry by entry, so only a few files are open at a time
+			reader_lock lock(split.mutex);
+
+			if (!split.out)
+			{
+				lock.upgrade();
+
+				if (!split.out && !split.out.open(path, fs::write))
+				{
+					m_num_failures++;
+					pkg_log.error("Failed to open file %s (error=%s)", path, fs::g_tls_error);
+					break;
+				}
+			}
+		}
+
+		if (split.out.write_at(range.offset, buffer.data(), range.size) != range.size)
+		{
+			m_num_failures++;
+			pkg_log.error("Failed to write file %s (offset=0x%x, size=0x%x, error=%s)", path, range.offset, range.size, fs::g_tls_error);
+			break;
+		}
+
+		m_written_bytes += range.size;
+
+		if (split.ranges_left.fetch_sub(1) != 1)
+		{
+			continue;
+		}
+
+		// Last range of the entry: no other worker may access the file anymore
+		split.out.close();
+
+		if (split.did_overwrite)
+		{
+			pkg_log.warning("Overwritten file %s", path);
+		}
+		else
+		{
+			pkg_log.notice("Created file %s", path);
+
+			if (entry.name == "USRDIR/EBOOT.BIN")
+			{
+				// Expose the creation of a bootable file
+				m_bootable_file_path = path;
+			}
+		}
+	}
+}
+
 fs::file DecryptEDAT(const fs::file& input, const std::string& input_file_name, int mode, u8 *custom_klic);
 
 void package_reader::extract_worker()
 {
+	// Install large entries first so that all workers cooperate on them
+	extract_range_worker();
+
 	std::vector<u8> read_cache;
 
 	while (m_num_failures == 0 && !m_aborted)
@@ -971,7 +1176,7 @@ void package_reader::extract_worker()
 			break;
 		}
 
-		const install_entry& entry = ::at32(m_install_entries, index);
+		const install_entry& entry = ::at32(m_install_entries, m_install_order.empty() ? index : ::at32(m_install_order, index));
 
 		if (!entry.is_dominating())
 		{
@@ -980,6 +1185,25 @@ void package_reader::extract_worker()
 			continue;
 		}
 
+		if (entry.is_split)
+		{
+			// Installed by extract_range_worker
+			continue;
+		}
+
+		if (m_stream)
+		{
+			// Entries are received in file order, only EDAT decryption may need to look back
+			if ((entry.type & 0xff) == PKG_FILE_ENTRY_SDAT)
+			{
+				m_stream->retain_from(entry.file_offset);
+			}
+			else
+			{
+				m_stream->advance_to(entry.file_offset);
+			}
+		}
+
 		const bool is_psp = (entry.type & PKG_FILE_ENTRY_PSP) != 0u;
 
 		const std::string& path = entry.weak_reference->first;
@@ -1303,9 +1527,29 @@ package_install_result package_reader::extract_data(std::deque<package_reader>&
 
 		reader.m_num_failures = error == package_install_result::error_type::no_error ? 0 : 1;
 
+		// A streamed package can only be installed sequentially in file order
+		const usz max_threads = reader.m_stream ? 1 : utils::get_thread_count();
+
+		if (reader.m_num_failures == 0 && !reader.prepare_split_entries(max_threads))
+		{
+			reader.m_num_failures = 1;
+		}
+
+		reader.m_install_order.clear();
+
+		if (reader.m_stream)
+		{
+			reader.m_install_order.resize(reader.m_install_entries.size());
+			std::iota(reader.m_install_order.begin(), reader.m_install_order.end(), usz{0});
+			std::stable_sort(reader.m_install_order.begin(), reader.m_install_order.end(), [&](usz a, usz b)
+			{
+				return reader.m_install_entries[a].file_offset < reader.m_install_entries[b].file_offset;
+			});
+		}
+
 		if (reader.m_num_failures == 0)
 		{
-			const usz thread_count = std::min<usz>(utils::get_thread_count(), reader.m_install_entries.size());
+			const usz thread_count = std::min<usz>(max_threads, reader.m_install_entries.size() + reader.m_install_ranges.size());
 
 			named_thread_group workers("PKG Installer "sv, std::max<u32>(::narrow<u32>(thread_count), 1) - 1, [&]()
 			{
@@ -1316,10 +1560,19 @@ package_install_result package_reader::extract_data(std::deque<package_reader>&
 			workers.join();
 		}
 
+		// Close files of unfinished split entries (failure or abort)
+		reader.m_install_splits.clear();
+
+		if (reader.m_stream && reader.m_num_failures == 0 && !reader.m_aborted && !reader.m_stream->finish())
+		{
+			pkg_log.error("Streamed package could not be verified ('%s')", reader.m_path);
+			reader.m_num_failures++;
+		}
+
 		num_failures += reader.m_num_failures;
 
 		// We don't count this package as aborted if all entries were processed.
-		if (reader.m_num_failures || (reader.m_aborted && reader.m_entry_indexer < reader.m_install_entries.size()))
+		if (reader.m_num_failures || (reader.m_aborted && (reader.m_entry_indexer < reader.m_install_entries.size() || reader.m_range_indexer < reader.m_install_ranges.size())))
 		{
 			// Clear boot path. We don't want to propagate potentially broken paths to the caller.
 			reader.m_bootable_file_path.clear();
@@ -1481,4 +1734,260 @@ int package_reader::get_progress(int maximum) const
 void package_reader::abort_extract()
 {
 	m_aborted = true;
+
+	if (m_stream)
+	{
+		m_stream->abort();
+	}
+}
+
+pkg_stream::pkg_stream(fs::file source, u32 timeout)
+	: m_source(std::move(source))
+	, m_timeout(timeout)
+{
+	sha1_starts(&m_sha1);
+
+	// Receive the beginning of the header to learn the package size
+	if (!m_source || !receive(PKG_HEADER_SIZE))
+	{
+		pkg_log.error("PKG stream: failed to receive the header (received=0x%x)", m_received.load());
+		return;
+	}
+
+	m_size = read_from_ptr<be_t<u64>>(m_buffer.data(), 0x18); // PKGHeader::pkg_size
+
+	if (m_size < PKG_HEADER_SIZE + DIGEST_SIZE)
+	{
+		pkg_log.error("PKG stream: invalid package size (0x%x)", m_size);
+		m_size = 0;
+	}
+}
+
+void pkg_stream::retain_from(u64 offset)
+{
+	std::lock_guard lock(m_mutex);
+
+	m_keep_pos = offset;
+	m_sequential = false;
+	discard();
+}
+
+void pkg_stream::advance_to(u64 offset)
+{
+	std::lock_guard lock(m_mutex);
+
+	m_keep_pos = offset;
+	m_read_end = offset;
+	m_sequential = true;
+	discard();
+}
+
+bool pkg_stream::finish()
+{
+	std::lock_guard lock(m_mutex);
+
+	if (!m_size)
+	{
+		return false;
+	}
+
+	// Nothing has to be kept anymore
+	m_keep_pos = m_size;
+	m_sequential = false;
+
+	if (!receive(m_size))
+	{
+		pkg_log.error("PKG stream: the package is incomplete (received=0x%x, size=0x%x)", m_received.load(), m_size);
+		return false;
+	}
+
+	std::array<u8, 20> digest{};
+	sha1_finish(&m_sha1, digest.data());
+
+	if (digest != m_digest)
+	{
+		pkg_log.error("PKG stream: digest mismatch");
+		return false;
+	}
+
+	pkg_log.notice("PKG stream: digest verified (size=0x%x)", m_size);
+	return true;
+}
+
+bool pkg_stream::receive(u64 end)
+{
+	if (m_size)
+	{
+		end = std::min(end, m_size);
+	}
+
+	auto last_progress = std::chrono::steady_clock::now();
+
+	while (m_received < end)
+	{
+		if (m_aborted || (thread_ctrl::get_current() && thread_ctrl::state() == thread_state::aborting))
+		{
+			return false;
+		}
+
+		discard();
+
+		if (m_buffer.size() > MAX_RETAINED_SIZE)
+		{
+			pkg_log.error("PKG stream: too much data retained at 0x%x (unsupported package layout)", m_buffer_pos);
+			return false;
+		}
+
+		const usz old_size = m_buffer.size();
+		const u64 count = std::min<u64>(RECEIVE_SIZE, end - m_received);
+
+		m_buffer.resize(old_size + count);
+
+		const u64 nread = m_source.read(m_buffer.data() + old_size, count);
+
+		m_buffer.resize(old_size + nread);
+
+		if (!nread)
+		{
+			// Wait for the writer (growing file or pipe with a slow producer)
+			if (m_timeout && std::chrono::steady_clock::now() - last_progress > std::chrono::seconds(m_timeout))
+			{
+				pkg_log.error("PKG stream: no data received for %u seconds (received=0x%x)", m_timeout, m_received.load());
+				return false;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+			continue;
+		}
+
+		last_progress = std::chrono::steady_clock::now();
+
+		update_digest(m_received, m_buffer.data() + old_size, nread);
+		m_received += nread;
+	}
+
+	return true;
+}
+
+void pkg_stream::discard()
+{
+	u64 keep_pos = m_keep_pos;
+
+	if (m_sequential && m_read_end > WINDOW_SIZE)
+	{
+		keep_pos = std::max(keep_pos, m_read_end - WINDOW_SIZE);
+	}
+
+	if (keep_pos <= m_buffer_pos)
+	{
+		return;
+	}
+
+	const u64 count = std::min<u64>(keep_pos - m_buffer_pos, m_buffer.size());
+
+	// Avoid moving the buffer contents for small gains
+	if (count != m_buffer.size() && count < WINDOW_SIZE / 4)
+	{
+		return;
+	}
+
+	m_buffer.erase(m_buffer.begin(), m_buffer.begin() + count);
+	m_buffer_pos += count;
+}
+
+void pkg_stream::update_digest(u64 pos, const u8* data, u64 size)
+{
+	// The size is unknown only while the beginning of the header is received
+	const u64 digest_pos = m_size ? m_size - DIGEST_SIZE : u64{umax};
+
+	if (pos < digest_pos)
+	{
+		sha1_update(&m_sha1, data, std::min(size, digest_pos - pos));
+	}
+
+	for (u64 i = std::max(pos, digest_pos); i < pos + size && i - digest_pos < m_digest.size(); i++)
+	{
+		m_digest[i - digest_pos] = data[i - pos];
+	}
+}
+
+bool pkg_stream::trunc(u64)
+{
+	return false;
+}
+
+u64 pkg_stream::read(void* buffer, u64 size)
+{
+	const u64 result = read_at(m_pos, buffer, size);
+	m_pos += result;
+	return result;
+}
+
+u64 pkg_stream::read_at(u64 offset, void* buffer, u64 size)
+{
+	std::lock_guard lock(m_mutex);
+
+	if (offset >= m_size || !size)
+	{
+		return 0;
+	}
+
+	size = std::min(size, m_size - offset);
+
+	if (offset < m_buffer_pos)
+	{
+		pkg_log.error("PKG stream: data at 0x%x was already discarded (non-sequential read)", offset);
+		fs::g_tls_error = fs::error::inval;
+		return 0;
+	}
+
+	m_read_end = std::max(m_read_end, offset + size);
+
+	if (!receive(offset + size))
+	{
+		size = m_received > offset ? m_received - offset : 0;
+	}
+
+	if (offset < m_buffer_pos || !size)
+	{
+		return 0;
+	}
+
+	std::memcpy(buffer, m_buffer.data() + (offset - m_buffer_pos), size);
+	return size;
+}
+
+u64 pkg_stream::write(const void*, u64)
+{
+	return 0;
+}
+
+u64 pkg_stream::seek(s64 offset, fs::seek_mode whence)
+{
+	const s64 new_pos =
+		whence == fs::seek_set ? offset :
+		whence == fs::seek_cur ? offset + m_pos :
+		whence == fs::seek_end ? offset + size() : -1;
+
+	if (new_pos < 0)
+	{
+		fs::g_tls_error = fs::error::inval;
+		return -1;
+	}
+
+	m_pos = new_pos;
+	return m_pos;
+}
+
+u64 pkg_stream::size()
+{
+	return m_size;
+}
+
+fs::file_id pkg_stream::get_id()
+{
+	fs::file_id id{};
+
+	id.type.insert(0, "pkg_stream: "sv);
+	return id;
 }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "Loader/PSF.h"
+#include "sha1.h"
 #include "util/endian.hpp"
 #include "util/types.hpp"
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
 #include <sstream>
 #include <iomanip>
 #include <span>
@@ -312,6 +314,69 @@ struct package_install_result
 	} version;
 };
 
+// Forward-only view of a PKG received from a non-seekable source (pipe, FIFO or growing file).
+// The SHA-1 digest stored at the end of the package is verified while the data arrives.
+class pkg_stream final : public fs::file_base
+{
+public:
+	// Seconds to wait for more data before the installation fails (0: wait until the whole package is received or installation is aborted)
+	static constexpr u32 DEFAULT_TIMEOUT = 10;
+
+	explicit pkg_stream(fs::file source, u32 timeout = DEFAULT_TIMEOUT);
+
+	// Keep all data from offset until the next call (header, entry table and names, EDAT entries)
+	void retain_from(u64 offset);
+
+	// Discard all data below offset, afterwards only keep a small window behind the last read
+	void advance_to(u64 offset);
+
+	// Receive the rest of the package and verify its digest
+	bool finish();
+
+	void abort()
+	{
+		m_aborted = true;
+	}
+
+	u64 received() const
+	{
+		return m_received;
+	}
+
+	bool trunc(u64) override;
+	u64 read(void* buffer, u64 size) override;
+	u64 read_at(u64 offset, void* buffer, u64 size) override;
+	u64 write(const void*, u64) override;
+	u64 seek(s64 offset, fs::seek_mode whence) override;
+	u64 size() override;
+	fs::file_id get_id() override;
+
+private:
+	bool receive(u64 end);
+	void discard();
+	void update_digest(u64 pos, const u8* data, u64 size);
+
+	static constexpr u64 DIGEST_SIZE = 0x20; // SHA-1 of all preceding data + padding
+	static constexpr u64 RECEIVE_SIZE = 1024 * 1024;
+	static constexpr u64 WINDOW_SIZE = 16 * 1024 * 1024;
+	static constexpr u64 MAX_RETAINED_SIZE = 1024 * 1024 * 1024;
+
+	fs::file m_source;
+	shared_mutex m_mutex;
+	std::vector<u8> m_buffer; // Data in [m_buffer_pos, m_received)
+	u64 m_buffer_pos = 0;
+	u64 m_keep_pos = 0;
+	u64 m_read_end = 0;
+	u64 m_pos = 0;
+	u64 m_size = 0;
+	bool m_sequential = false;
+	atomic_t<u64> m_received = 0;
+	atomic_t<bool> m_aborted = false;
+	u32 m_timeout = DEFAULT_TIMEOUT;
+	sha1_context m_sha1{};
+	std::array<u8, 20> m_digest{};
+};
+
 class package_reader
 {
 	struct install_entry
@@ -324,6 +389,9 @@ class package_reader
 		u32 type{};
 		u32 pad{};
 
+		// Installed in ranges by all workers (see prepare_split_entries)
+		bool is_split{};
+
 		// Check if the entry is the same one registered in entries to install
 		bool is_dominating() const
 		{
@@ -331,8 +399,24 @@ class package_reader
 		}
 	};
 
+	struct install_split
+	{
+		const install_entry* entry{};
+		shared_mutex mutex; // Protects opening of out
+		fs::file out{}; // Opened by the first worker which writes a range of the entry
+		bool did_overwrite{};
+		atomic_t<usz> ranges_left{};
+	};
+
+	struct install_range
+	{
+		usz split_index{};
+		u64 offset{};
+		u64 size{};
+	};
+
 public:
-	package_reader(const std::string& path, fs::file file = {});
+	package_reader(const std::string& path, fs::file file = {}, bool streaming = false, u32 stream_timeout = pkg_stream::DEFAULT_TIMEOUT);
 	~package_reader();
 
 	enum result
@@ -372,20 +456,27 @@ private:
 	u64 archive_read(void* data_ptr, u64 num_bytes);
 	bool set_install_path();
 	bool fill_data(std::map<std::string, install_entry*>& all_install_entries);
+	bool prepare_split_entries(usz thread_count);
 	std::span<const char> archive_read_block(u64 offset, void* data_ptr, u64 num_bytes);
 	usz decrypt(u64 offset, u64 size, const uchar* key, void* local_buf);
 	void extract_worker();
+	void extract_range_worker();
 
 	std::deque<install_entry> m_install_entries;
+	std::vector<usz> m_install_order; // Entries in file order (streaming mode)
 	std::string m_install_path;
 	atomic_t<bool> m_aborted = false;
 	atomic_t<usz> m_num_failures = 0;
+	std::deque<install_split> m_install_splits;
+	std::vector<install_range> m_install_ranges;
 	atomic_t<usz> m_entry_indexer = 0;
+	atomic_t<usz> m_range_indexer = 0;
 	atomic_t<usz> m_written_bytes = 0;
 	bool m_was_null = false;
 
 	static constexpr usz BUF_SIZE = 8192 * 1024; // 8 MB
 	static constexpr usz BUF_PADDING = 32;
+	static constexpr usz SPLIT_THRESHOLD = BUF_SIZE * 4; // Entries of at least 32 MB are split into BUF_SIZE ranges
 
 	bool m_is_valid = false;
 	result m_result = result::not_started;
@@ -393,6 +484,7 @@ private:
 	std::string m_path{};
 	std::string m_install_dir{};
 	fs::file m_file{};
+	pkg_stream* m_stream = nullptr; // Owned by m_file in streaming mode
 	std::array<uchar, 16> m_dec_key{};
 
 	PKGHeader m_header{};
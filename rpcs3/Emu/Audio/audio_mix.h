@@ -0,0 +1,220 @@
+#pragma once
+
+#include "Emu/Audio/AudioBackend.h"
+#include "util/endian.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
+
+namespace audio
+{
+	constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
+
+	// Mix 'frames' frames of a port with 'in_channels' big-endian channels into the output buffer (one frame at a time).
+	// With 'ramp', volume[i] is applied to frame i, otherwise volume[0] is applied to all frames.
+	template <AudioChannelCnt channels, AudioChannelCnt downmix, u32 in_channels, bool ramp>
+	void mix_port_scalar(float* out_buffer, const be_t<f32>* buf, const f32* volume, u32 first, u32 frames)
+	{
+		constexpr u32 out_channels = static_cast<u32>(channels);
+
+		for (u32 frame = first, out = first * out_channels, in = first * in_channels; frame < frames; frame++, out += out_channels, in += in_channels)
+		{
+			const float m = volume[ramp ? frame : 0];
+
+			if constexpr (in_channels == 2)
+			{
+				out_buffer[out + 0] += buf[in + 0] * m;
+				out_buffer[out + 1] += buf[in + 1] * m;
+			}
+			else
+			{
+				const float left       = buf[in + 0] * m;
+				const float right      = buf[in + 1] * m;
+				const float center     = buf[in + 2] * m;
+				const float low_freq   = buf[in + 3] * m;
+				const float side_left  = buf[in + 4] * m;
+				const float side_right = buf[in + 5] * m;
+				const float rear_left  = buf[in + 6] * m;
+				const float rear_right = buf[in + 7] * m;
+
+				if constexpr (downmix == AudioChannelCnt::STEREO)
+				{
+					// Don't mix in the lfe as per dolby specification and based on documentation
+					const float mid = center * 0.5f;
+					out_buffer[out + 0] += left * minus_3db + mid + side_left * 0.5f + rear_left * 0.5f;
+					out_buffer[out + 1] += right * minus_3db + mid + side_right * 0.5f + rear_right * 0.5f;
+				}
+				else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
+				{
+					out_buffer[out + 0] += left;
+					out_buffer[out + 1] += right;
+
+					if constexpr (out_channels >= 6) // Only mix the surround channels into the output if surround output is configured
+					{
+						out_buffer[out + 2] += center;
+						out_buffer[out + 3] += low_freq;
+
+						if constexpr (out_channels == 6)
+						{
+							out_buffer[out + 4] += side_left + rear_left;
+							out_buffer[out + 5] += side_right + rear_right;
+						}
+						else // When using 7.1 ouput, out_buffer[out + 4] and out_buffer[out + 5] are the rear channels, so the side channels need to be mixed into [out + 6] and [out + 7]
+						{
+							out_buffer[out + 6] += side_left + rear_left;
+							out_buffer[out + 7] += side_right + rear_right;
+						}
+					}
+				}
+				else
+				{
+					out_buffer[out + 0] += left;
+					out_buffer[out + 1] += right;
+
+					if constexpr (out_channels >= 6) // Only mix the surround channels into the output if surround output is configured
+					{
+						out_buffer[out + 2] += center;
+						out_buffer[out + 3] += low_freq;
+
+						if constexpr (out_channels == 6)
+						{
+							out_buffer[out + 4] += side_left;
+							out_buffer[out + 5] += side_right;
+						}
+						else
+						{
+							out_buffer[out + 4] += rear_left;
+							out_buffer[out + 5] += rear_right;
+							out_buffer[out + 6] += side_left;
+							out_buffer[out + 7] += side_right;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// Vectorized version of mix_port_scalar (byteswap, scale and accumulate 4 samples at once)
+	template <AudioChannelCnt channels, AudioChannelCnt downmix, u32 in_channels, bool ramp>
+	void mix_port(float* out_buffer, const be_t<f32>* buf, const f32* volume, u32 frames)
+	{
+		static_assert(in_channels == 2 || in_channels == 8);
+
+		constexpr u32 out_channels = static_cast<u32>(channels);
+
+		const v128 zero = gv_bcstfs(0.0f);
+		const v128 constant_volume = gv_bcstfs(volume[0]);
+
+		const auto get_volume = [&](u32 frame)
+		{
+			return ramp ? gv_bcstfs(volume[frame]) : constant_volume;
+		};
+
+		const auto load = [&](u32 in)
+		{
+			return gv_to_be32(v128::loadu(buf + in));
+		};
+
+		const auto accumulate = [&](u32 out, const v128& value)
+		{
+			v128::storeu(gv_addfs(v128::loadu(out_buffer + out), value), out_buffer + out);
+		};
+
+		// Values to accumulate into out_buffer[out + 0..3] and out_buffer[out + 4..7] for two consecutive frames
+		// (only the first two lanes of 'hi' are used with 5.1 output, and only the first two lanes of 'lo' with stereo output)
+		const auto mix_frames = [&](u32 frame, v128 (&lo)[2], v128 (&hi)[2])
+		{
+			if constexpr (in_channels == 2)
+			{
+				const v128 m = ramp ? gv_shufflefs<0, 0, 0, 0>(get_volume(frame), get_volume(frame + 1)) : constant_volume;
+				const v128 samples = gv_mulfs(load(frame * 2), m); // left, right of both frames
+
+				lo[0] = gv_shufflefs<0, 1, 0, 1>(samples, zero);
+				lo[1] = gv_shufflefs<2, 3, 0, 1>(samples, zero);
+				hi[0] = zero;
+				hi[1] = zero;
+				return;
+			}
+
+			for (u32 i = 0; i < 2; i++)
+			{
+				const v128 m = get_volume(frame + i);
+				const v128 front = gv_mulfs(load((frame + i) * 8), m); // left, right, center, low_freq
+
+				if constexpr (out_channels == 2 && downmix != AudioChannelCnt::STEREO)
+				{
+					// Only left and right are used
+					lo[i] = front;
+					hi[i] = zero;
+					continue;
+				}
+
+				const v128 back = gv_mulfs(load((frame + i) * 8 + 4), m); // side_left, side_right, rear_left, rear_right
+
+				if constexpr (downmix == AudioChannelCnt::STEREO)
+				{
+					// Don't mix in the lfe as per dolby specification and based on documentation
+					const v128 surround = gv_addfs(back, gv_shuffle32<2, 3, 0, 1>(back));
+					const v128 mid = gv_shuffle32<2, 2, 2, 2>(front);
+					const v128 sum = gv_addfs(gv_addfs(gv_mulfs(front, minus_3db), gv_mulfs(mid, 0.5f)), gv_mulfs(surround, 0.5f));
+					lo[i] = gv_shufflefs<0, 1, 0, 1>(sum, zero);
+					hi[i] = zero;
+				}
+				else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
+				{
+					lo[i] = front;
+
+					// { side_left + rear_left, side_right + rear_right }
+					const v128 surround = gv_addfs(back, gv_shuffle32<2, 3, 0, 1>(back));
+					hi[i] = out_channels == 6 ? surround : gv_shufflefs<0, 0, 0, 1>(zero, surround);
+				}
+				else
+				{
+					lo[i] = front;
+					hi[i] = out_channels == 6 ? back : gv_shuffle32<2, 3, 0, 1>(back);
+				}
+			}
+		};
+
+		u32 frame = 0;
+
+		for (; frame + 2 <= frames; frame += 2)
+		{
+			if constexpr (in_channels == 2 && out_channels == 2)
+			{
+				// Two frames per vector, nothing to rearrange
+				const v128 m = ramp ? gv_shufflefs<0, 0, 0, 0>(get_volume(frame), get_volume(frame + 1)) : constant_volume;
+				accumulate(frame * 2, gv_mulfs(load(frame * 2), m));
+				continue;
+			}
+
+			v128 lo[2], hi[2];
+			mix_frames(frame, lo, hi);
+
+			if constexpr (out_channels == 2)
+			{
+				accumulate(frame * 2, gv_shufflefs<0, 1, 0, 1>(lo[0], lo[1]));
+			}
+			else if constexpr (out_channels == 6)
+			{
+				// Two frames fill three vectors
+				accumulate(frame * 6 + 0, lo[0]);
+				accumulate(frame * 6 + 4, gv_shufflefs<0, 1, 0, 1>(hi[0], lo[1]));
+				accumulate(frame * 6 + 8, gv_shufflefs<2, 3, 0, 1>(lo[1], hi[1]));
+			}
+			else
+			{
+				accumulate(frame * 8 + 0, lo[0]);
+				accumulate(frame * 8 + 8, lo[1]);
+
+				if constexpr (in_channels == 8)
+				{
+					accumulate(frame * 8 + 4, hi[0]);
+					accumulate(frame * 8 + 12, hi[1]);
+				}
+			}
+		}
+
+		// Remaining frames
+		mix_port_scalar<channels, downmix, in_channels, ramp>(out_buffer, buf, volume, frame, frames);
+	}
+}
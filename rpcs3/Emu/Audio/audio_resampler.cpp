@@ -1,59 +1,137 @@
 #include "stdafx.h"
 #include "Emu/Audio/audio_resampler.h"
+#include "Emu/Audio/audio_sinc_resampler.h"
 #include <algorithm>
 
+#ifndef _MSC_VER
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#endif
+#include "SoundTouch.h"
+#ifndef _MSC_VER
+#pragma GCC diagnostic pop
+#endif
+
+namespace
+{
+	class soundtouch_resampler final : public audio_resampler_backend
+	{
+	public:
+		soundtouch_resampler()
+		{
+			// Improved quality settings for better audio output
+			resampler.setSetting(SETTING_SEQUENCE_MS, 40);   // Increased sequence length for better quality (was 20)
+			resampler.setSetting(SETTING_SEEKWINDOW_MS, 15); // Better seeking window for smoother transitions
+			resampler.setSetting(SETTING_OVERLAP_MS, 8);     // Improved overlap for better quality
+			resampler.setSetting(SETTING_USE_QUICKSEEK, 0);  // Disable quick seek for higher quality (was 1)
+			resampler.setSetting(SETTING_USE_AA_FILTER, 1);  // Enable anti-aliasing filter for cleaner sound
+		}
+
+		void set_params(u32 ch_cnt, u32 freq) override
+		{
+			resampler.setChannels(ch_cnt);
+			resampler.setSampleRate(freq);
+		}
+
+		void set_tempo(f64 tempo) override
+		{
+			resampler.setTempo(tempo);
+		}
+
+		void put_samples(const f32* buf, u32 sample_cnt) override
+		{
+			resampler.putSamples(buf, sample_cnt);
+		}
+
+		std::pair<f32*, u32> get_samples(u32 sample_cnt) override
+		{
+			// NOTE: Make sure to get the buffer first because receiveSamples advances its position internally
+			//       and std::make_pair evaluates the second parameter first...
+			f32* const buf = resampler.bufBegin();
+			return std::make_pair(buf, resampler.receiveSamples(sample_cnt));
+		}
+
+		u32 samples_available() const override
+		{
+			return resampler.numSamples();
+		}
+
+		f64 get_resample_ratio() const override
+		{
+			return resampler.getInputOutputSampleRatio();
+		}
+
+		void flush() override
+		{
+			resampler.clear();
+		}
+
+	private:
+		soundtouch::SoundTouch resampler{};
+	};
+}
+
 audio_resampler::audio_resampler()
+	: m_backend(make_backend(m_type))
 {
-	// Improved quality settings for better audio output
-	resampler.setSetting(SETTING_SEQUENCE_MS, 40);   // Increased sequence length for better quality (was 20)
-	resampler.setSetting(SETTING_SEEKWINDOW_MS, 15); // Better seeking window for smoother transitions
-	resampler.setSetting(SETTING_OVERLAP_MS, 8);     // Improved overlap for better quality
-	resampler.setSetting(SETTING_USE_QUICKSEEK, 0);  // Disable quick seek for higher quality (was 1)
-	resampler.setSetting(SETTING_USE_AA_FILTER, 1);  // Enable anti-aliasing filter for cleaner sound
 }
 
 audio_resampler::~audio_resampler()
 {
 }
 
-void audio_resampler::set_params(AudioChannelCnt ch_cnt, AudioFreq freq)
+std::unique_ptr<audio_resampler_backend> audio_resampler::make_backend(audio_resampler_type type)
+{
+	switch (type)
+	{
+	case audio_resampler_type::sinc: return std::make_unique<sinc_resampler>();
+	case audio_resampler_type::soundtouch: break;
+	}
+
+	return std::make_unique<soundtouch_resampler>();
+}
+
+void audio_resampler::set_params(AudioChannelCnt ch_cnt, AudioFreq freq, audio_resampler_type type)
 {
+	if (type != m_type)
+	{
+		m_type = type;
+		m_backend = make_backend(type);
+	}
+
 	flush();
-	resampler.setChannels(static_cast<u32>(ch_cnt));
-	resampler.setSampleRate(static_cast<u32>(freq));
+	m_backend->set_params(static_cast<u32>(ch_cnt), static_cast<u32>(freq));
 }
 
 f64 audio_resampler::set_tempo(f64 new_tempo)
 {
 	new_tempo = std::clamp(new_tempo, RESAMPLER_MIN_FREQ_VAL, RESAMPLER_MAX_FREQ_VAL);
-	resampler.setTempo(new_tempo);
+	m_backend->set_tempo(new_tempo);
 	return new_tempo;
 }
 
 void audio_resampler::put_samples(const f32* buf, u32 sample_cnt)
 {
-	resampler.putSamples(buf, sample_cnt);
+	m_backend->put_samples(buf, sample_cnt);
 }
 
 std::pair<f32* /* buffer */, u32 /* samples */> audio_resampler::get_samples(u32 sample_cnt)
 {
-	// NOTE: Make sure to get the buffer first because receiveSamples advances its position internally
-	//       and std::make_pair evaluates the second parameter first...
-	f32* const buf = resampler.bufBegin();
-	return std::make_pair(buf, resampler.receiveSamples(sample_cnt));
+	return m_backend->get_samples(sample_cnt);
 }
 
 u32 audio_resampler::samples_available() const
 {
-	return resampler.numSamples();
+	return m_backend->samples_available();
 }
 
 f64 audio_resampler::get_resample_ratio()
 {
-	return resampler.getInputOutputSampleRatio();
+	return m_backend->get_resample_ratio();
 }
 
 void audio_resampler::flush()
 {
-	resampler.clear();
+	m_backend->flush();
 }
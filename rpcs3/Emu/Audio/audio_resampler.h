@@ -2,27 +2,40 @@
 
 #include "util/types.hpp"
 #include "Emu/Audio/AudioBackend.h"
+#include "Emu/system_config_types.h"
 
-#ifndef _MSC_VER
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wsuggest-override"
-#pragma GCC diagnostic ignored "-Wold-style-cast"
-#endif
-#include "SoundTouch.h"
-#ifndef _MSC_VER
-#pragma GCC diagnostic pop
-#endif
+#include <memory>
 
 constexpr f64 RESAMPLER_MAX_FREQ_VAL = 1.0;
 constexpr f64 RESAMPLER_MIN_FREQ_VAL = 0.1;
 
+// Time stretching implementation, sample counts are in frames of interleaved channels
+class audio_resampler_backend
+{
+public:
+	virtual ~audio_resampler_backend() = default;
+
+	virtual void set_params(u32 ch_cnt, u32 freq) = 0;
+	virtual void set_tempo(f64 tempo) = 0;
+
+	virtual void put_samples(const f32* buf, u32 sample_cnt) = 0;
+
+	// The returned buffer stays valid until the next call to put_samples or flush
+	virtual std::pair<f32* /* buffer */, u32 /* samples */> get_samples(u32 sample_cnt) = 0;
+
+	virtual u32 samples_available() const = 0;
+	virtual f64 get_resample_ratio() const = 0;
+
+	virtual void flush() = 0;
+};
+
 class audio_resampler
 {
 public:
 	audio_resampler();
 	~audio_resampler();
 
-	void set_params(AudioChannelCnt ch_cnt, AudioFreq freq);
+	void set_params(AudioChannelCnt ch_cnt, AudioFreq freq, audio_resampler_type type);
 	f64 set_tempo(f64 new_tempo);
 
 	void put_samples(const f32* buf, u32 sample_cnt);
@@ -33,6 +46,9 @@ public:
 
 	void flush();
 
+	static std::unique_ptr<audio_resampler_backend> make_backend(audio_resampler_type type);
+
 private:
-	soundtouch::SoundTouch resampler{};
+	audio_resampler_type m_type = audio_resampler_type::soundtouch;
+	std::unique_ptr<audio_resampler_backend> m_backend;
 };
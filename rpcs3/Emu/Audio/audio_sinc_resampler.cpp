@@ -0,0 +1,226 @@
+#include "stdafx.h"
+#include "Emu/Audio/audio_sinc_resampler.h"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+	constexpr u32 taps = sinc_resampler::taps;
+	constexpr u32 phases = sinc_resampler::phases;
+
+	// Passband edge relative to the input Nyquist frequency and Kaiser window shape (~80 dB stopband)
+	constexpr f64 filter_cutoff = 0.9;
+	constexpr f64 filter_beta = 8.0;
+
+	// Modified Bessel function of the first kind (order 0), std::cyl_bessel_i isn't available everywhere
+	f64 bessel_i0(f64 x)
+	{
+		f64 sum = 1.0;
+		f64 term = 1.0;
+
+		for (u32 k = 1; k < 64 && term > sum * 1e-12; k++)
+		{
+			const f64 half = x / (2.0 * k);
+			term *= half * half;
+			sum += term;
+		}
+
+		return sum;
+	}
+
+	// Row p holds the taps for an output frame p / phases after the center of the window.
+	// The extra row allows interpolating between the last phase and the next input frame.
+	const std::array<f32, (phases + 1) * taps>& get_filter_table()
+	{
+		static const auto s_table = []()
+		{
+			std::array<f32, (phases + 1) * taps> table{};
+
+			for (u32 p = 0; p <= phases; p++)
+			{
+				f64 row[taps]{};
+				f64 sum = 0.0;
+
+				for (u32 k = 0; k < taps; k++)
+				{
+					const f64 x = static_cast<f64>(k) - (taps / 2 - 1) - static_cast<f64>(p) / phases;
+					const f64 r = x / (taps / 2);
+					const f64 window = bessel_i0(filter_beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / bessel_i0(filter_beta);
+					const f64 y = std::numbers::pi * filter_cutoff * x;
+
+					row[k] = (x == 0.0 ? 1.0 : std::sin(y) / y) * window;
+					sum += row[k];
+				}
+
+				// Normalize to unity gain
+				for (u32 k = 0; k < taps; k++)
+				{
+					table[p * taps + k] = static_cast<f32>(row[k] / sum);
+				}
+			}
+
+			return table;
+		}();
+
+		return s_table;
+	}
+}
+
+sinc_resampler::sinc_resampler()
+{
+	get_filter_table();
+	set_params(2, 48000);
+}
+
+void sinc_resampler::set_params(u32 ch_cnt, u32 /*freq*/)
+{
+	// The filter only depends on the ratio
+	m_channels = std::max<u32>(ch_cnt, 1);
+	m_input.resize(m_channels);
+	flush();
+}
+
+void sinc_resampler::set_tempo(f64 tempo)
+{
+	m_tempo = tempo;
+
+	if (tempo == 1.0 && m_frac != 0.0)
+	{
+		// Snap to the nearest input frame (a jump of at most half a frame) so the unfiltered path can be used again
+		m_pos += m_frac >= 0.5;
+		m_frac = 0.0;
+	}
+}
+
+void sinc_resampler::put_samples(const f32* buf, u32 sample_cnt)
+{
+	// Discard the consumed output, this invalidates the buffer returned by get_samples
+	m_output.erase(m_output.begin(), m_output.begin() + m_output_pos);
+	m_output_pos = 0;
+
+	for (u32 ch = 0; ch < m_channels; ch++)
+	{
+		std::vector<f32>& input = m_input[ch];
+		const usz old_size = input.size();
+		input.resize(old_size + sample_cnt);
+
+		for (u32 i = 0; i < sample_cnt; i++)
+		{
+			input[old_size + i] = buf[i * m_channels + ch];
+		}
+	}
+
+	process();
+}
+
+void sinc_resampler::process()
+{
+	const usz frames = m_input[0].size();
+
+	if (m_pos + taps > frames)
+	{
+		return;
+	}
+
+	m_output.reserve(m_output.size() + static_cast<usz>((frames - taps - m_pos + 1) / m_tempo + 1) * m_channels);
+
+	if (m_tempo == 1.0 && m_frac == 0.0)
+	{
+		// Nothing to interpolate, output the center of each window
+		for (; m_pos + taps <= frames; m_pos++)
+		{
+			for (u32 ch = 0; ch < m_channels; ch++)
+			{
+				m_output.push_back(m_input[ch][m_pos + taps / 2 - 1]);
+			}
+		}
+	}
+	else
+	{
+		const f32* const table = get_filter_table().data();
+
+		for (; m_pos + taps <= frames;)
+		{
+			// Interpolate the filter between the two nearest phases
+			const f64 phase = m_frac * phases;
+			const u32 index = static_cast<u32>(phase);
+			const v128 t = gv_bcstfs(static_cast<f32>(phase - index));
+			const f32* const row = table + index * taps;
+
+			v128 coefs[taps / 4];
+
+			for (u32 i = 0; i < taps / 4; i++)
+			{
+				const v128 c0 = v128::loadu(row + i * 4);
+				const v128 c1 = v128::loadu(row + taps + i * 4);
+				coefs[i] = gv_muladdfs(gv_subfs(c1, c0), t, c0);
+			}
+
+			for (u32 ch = 0; ch < m_channels; ch++)
+			{
+				const f32* const in = m_input[ch].data() + m_pos;
+
+				v128 sum = gv_mulfs(v128::loadu(in), coefs[0]);
+
+				for (u32 i = 1; i < taps / 4; i++)
+				{
+					sum = gv_muladdfs(v128::loadu(in + i * 4), coefs[i], sum);
+				}
+
+				const v128 half = gv_addfs(sum, gv_shufflefs<2, 3, 0, 1>(sum, sum));
+				const v128 total = gv_addfs(half, gv_shufflefs<1, 0, 3, 2>(half, half));
+				m_output.push_back(total._f[0]);
+			}
+
+			m_frac += m_tempo;
+
+			const f64 whole = std::floor(m_frac);
+			m_pos += static_cast<usz>(whole);
+			m_frac -= whole;
+		}
+	}
+
+	// Keep only the frames still needed by the filter window
+	for (std::vector<f32>& input : m_input)
+	{
+		input.erase(input.begin(), input.begin() + std::min(m_pos, input.size()));
+	}
+
+	m_pos -= std::min(m_pos, frames);
+}
+
+std::pair<f32*, u32> sinc_resampler::get_samples(u32 sample_cnt)
+{
+	const u32 count = std::min(sample_cnt, samples_available());
+	f32* const buf = m_output.data() + m_output_pos;
+	m_output_pos += count * m_channels;
+	return std::make_pair(buf, count);
+}
+
+u32 sinc_resampler::samples_available() const
+{
+	return static_cast<u32>((m_output.size() - m_output_pos) / m_channels);
+}
+
+f64 sinc_resampler::get_resample_ratio() const
+{
+	return m_tempo;
+}
+
+void sinc_resampler::flush()
+{
+	m_output.clear();
+	m_output_pos = 0;
+	m_frac = 0.0;
+	m_pos = 0;
+
+	// Start with half a window of silence so the first input frame is at the center of the first output
+	for (std::vector<f32>& input : m_input)
+	{
+		input.assign(taps / 2 - 1, 0.0f);
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Emu/Audio/audio_resampler.h"
+
+#include <vector>
+
+// Polyphase windowed-sinc resampler used for time stretching on slow hosts.
+// Unlike SoundTouch it doesn't preserve the pitch, but it only costs a short dot product per output sample
+// and adds a delay of half the filter length instead of a whole overlap-add sequence.
+class sinc_resampler final : public audio_resampler_backend
+{
+public:
+	static constexpr u32 taps = 32;    // Filter length in input frames (must be a multiple of 4)
+	static constexpr u32 phases = 128; // Number of precomputed fractional positions (interpolated in between)
+
+	sinc_resampler();
+
+	void set_params(u32 ch_cnt, u32 freq) override;
+	void set_tempo(f64 tempo) override;
+
+	void put_samples(const f32* buf, u32 sample_cnt) override;
+	std::pair<f32*, u32> get_samples(u32 sample_cnt) override;
+
+	u32 samples_available() const override;
+	f64 get_resample_ratio() const override;
+
+	void flush() override;
+
+private:
+	void process();
+
+	u32 m_channels = 2;
+	f64 m_tempo = 1.0;
+	f64 m_frac = 0.0;                      // Fractional position of the next output frame between two input frames
+	usz m_pos = 0;                         // First input frame in the filter window of the next output frame
+	std::vector<std::vector<f32>> m_input; // Planar input history, one vector per channel
+	std::vector<f32> m_output;             // Interleaved output frames
+	usz m_output_pos = 0;                  // Read position in m_output (in samples)
+};
@@ -11,10 +11,13 @@
 #include "Emu/Cell/lv2/sys_spu.h"
 #include "Emu/Cell/PPUThread.h"
 #include "Emu/Cell/SPUThread.h"
+#include "Emu/Cell/SPURecompiler.h"
+#include "Emu/cache_utils.hpp"
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/perf_meter.hpp"
 
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 #include <thread>
 #include <unordered_map>
 #include <map>
@@ -169,6 +172,9 @@ struct cpu_prof
 		// Block occurences: name -> sample_count
 		std::unordered_map<u64, u64, value_hash<u64>> freq;
 
+		// Estimated block execution time: name -> microseconds
+		std::unordered_map<u64, u64, value_hash<u64>> time;
+
 		// Total number of samples
 		u64 samples = 0, idle = 0;
 
@@ -184,6 +190,7 @@ struct cpu_prof
 		void reset()
 		{
 			freq.clear();
+			time.clear();
 			samples = 0;
 			idle = 0;
 			new_samples = 0;
@@ -331,10 +338,52 @@ struct cpu_prof
 	sample_info all_spu_threads_info{};
 	sample_info all_ppu_threads_info{};
 
+	// Export SPU program hit counts and time for cache precompilation ordering
+	static void save_spu_profile(const std::unordered_map<shared_ptr<cpu_thread>, sample_info>& threads, const std::string& cache_path)
+	{
+		spu_cache::profile_t profile;
+
+		for (const auto& [ptr, info] : threads)
+		{
+			if (ptr->id_type() != 2)
+			{
+				continue;
+			}
+
+			for (const auto& [name, count] : info.freq)
+			{
+				// Skip unnamed code and verification time
+				if (name >> 16 == 0)
+				{
+					continue;
+				}
+
+				auto& [samples, time] = profile[name & ~0xffffull];
+				samples += count;
+
+				if (const auto found = info.time.find(name); found != info.time.end())
+				{
+					time += found->second;
+				}
+			}
+		}
+
+		if (!profile.empty())
+		{
+			spu_cache::save_profile(cache_path, profile);
+			profiler.notice("Saved SPU profile of %u program(s) to %sspu_profile.csv", profile.size(), cache_path);
+		}
+	}
+
 	void operator()()
 	{
 		std::unordered_map<shared_ptr<cpu_thread>, sample_info> threads;
 
+		// Location of the SPU profile
+		std::string cache_path;
+
+		u64 last_sample_time = get_system_time();
+
 		while (thread_ctrl::state() != thread_state::aborting)
 		{
 			bool flush = false;
@@ -358,6 +407,11 @@ struct cpu_prof
 				else if (id >> 24 == 2)
 				{
 					ptr = idm::get_unlocked<named_thread<spu_thread>>(id);
+
+					if (cache_path.empty())
+					{
+						cache_path = rpcs3::cache::get_ppu_cache();
+					}
 				}
 				else
 				{
@@ -385,6 +439,11 @@ struct cpu_prof
 				continue;
 			}
 
+			// Time since the last sample is attributed to the sampled blocks (capped to skip pauses)
+			const u64 sample_time = get_system_time();
+			const u64 delta = std::min<u64>(sample_time - last_sample_time, 10'000);
+			last_sample_time = sample_time;
+
 			// Sample active threads
 			for (auto& [ptr, info] : threads)
 			{
@@ -402,6 +461,7 @@ struct cpu_prof
 					if (cpu_flag::wait - state)
 					{
 						info.freq[name]++;
+						info.time[name] += delta;
 						info.new_samples++;
 
 						if (spu)
@@ -463,6 +523,11 @@ struct cpu_prof
 		// Print all remaining results
 		sample_info::print_all(threads, all_ppu_threads_info, 1);
 		sample_info::print_all(threads, all_spu_threads_info, 2);
+
+		if (!cache_path.empty())
+		{
+			save_spu_profile(threads, cache_path);
+		}
 	}
 
 	static constexpr auto thread_name = "CPU Profiler"sv;
@@ -513,6 +578,20 @@ static atomic_t<cpu_thread::suspend_work*> s_pushed{};
 // Lock for suspend_all operations
 static shared_mutex s_cpu_lock;
 
+// Statistics of suspend_all operations by call site (protected by s_cpu_lock)
+struct suspend_site_stats
+{
+	const char* func;
+	u64 works; // Total workloads executed
+	u64 owned; // Workloads which paused the threads (others have been coalesced into their batch)
+	u64 threads; // Sum of thread counts paused by owned workloads
+	u64 ticks; // Sum of pause durations of owned workloads
+	u64 max_ticks;
+};
+
+// Keyed by std::source_location::file_name() pointer and line
+static std::map<std::pair<const char*, u32>, suspend_site_stats> s_suspend_stats;
+
 // Bit allocator for threads which need to be suspended
 static atomic_t<u128> s_cpu_bits{};
 
@@ -684,6 +763,8 @@ void cpu_thread::operator()()
 	default: break;
 	}
 
+	start_tsc = utils::get_tsc();
+
 	// Register thread in g_cpu_array
 	s_cpu_counter++;
 
@@ -1080,6 +1161,8 @@ bool cpu_thread::check_state() noexcept
 			// If only cpu_flag::pause was set, wait on suspend counter instead
 			if (state0 & cpu_flag::pause)
 			{
+				const u64 pause_start = utils::get_tsc();
+
 				// Wait for current suspend_all operation
 				for (u64 i = 0;; i++)
 				{
@@ -1104,6 +1187,7 @@ bool cpu_thread::check_state() noexcept
 					}
 				}
 
+				suspended_time += utils::get_tsc() - pause_start;
 				continue;
 			}
 
@@ -1424,6 +1508,9 @@ bool cpu_thread::suspend_work::push(cpu_thread* _this) noexcept
 		// First thread to push the work to the workload list pauses all threads and processes it
 		std::lock_guard lock(s_cpu_lock);
 
+		const bool collect_stats = g_cfg.core.suspend_all_stats.get();
+		const u64 start_tsc = collect_stats ? utils::get_tsc() : 0;
+
 		u128 copy = s_cpu_bits.load();
 
 		// Try to prefetch cpu->state earlier
@@ -1508,13 +1595,16 @@ bool cpu_thread::suspend_work::push(cpu_thread* _this) noexcept
 		{
 			for (u32 i = 0; i < work->prf_size; i++)
 			{
-				utils::prefetch_write(work->prf_list[0]);
+				utils::prefetch_write(work->prf_list[i]);
 			}
 		}
 
+		u32 paused = 0;
+
 		cpu_counter::for_all_cpu(copy2, [&](cpu_thread* cpu)
 		{
 			utils::prefetch_write(&cpu->state);
+			paused++;
 			return true;
 		});
 
@@ -1532,6 +1622,21 @@ bool cpu_thread::suspend_work::push(cpu_thread* _this) noexcept
 			}
 		}
 
+		const u64 ticks = collect_stats ? utils::get_tsc() - start_tsc : 0;
+
+		// Copy call sites of coalesced workloads while they are still alive, statistics are updated after the pause
+		static thread_local std::vector<std::source_location> coalesced;
+
+		coalesced.clear();
+
+		for (auto work = head; collect_stats && work; work = work->next)
+		{
+			if (work != this)
+			{
+				coalesced.emplace_back(work->src_loc);
+			}
+		}
+
 		// Finalization (last increment)
 		ensure(g_suspend_counter++ & 1);
 
@@ -1540,6 +1645,24 @@ bool cpu_thread::suspend_work::push(cpu_thread* _this) noexcept
 			cpu->state -= cpu_flag::pause;
 			return true;
 		});
+
+		if (collect_stats)
+		{
+			auto& stats = s_suspend_stats[{src_loc.file_name(), src_loc.line()}];
+			stats.func = src_loc.function_name();
+			stats.works++;
+			stats.owned++;
+			stats.threads += paused;
+			stats.ticks += ticks;
+			stats.max_ticks = std::max(stats.max_ticks, ticks);
+
+			for (const auto& loc : coalesced)
+			{
+				auto& other = s_suspend_stats[{loc.file_name(), loc.line()}];
+				other.func = loc.function_name();
+				other.works++;
+			}
+		}
 	}
 	else
 	{
@@ -1564,6 +1687,51 @@ void cpu_thread::cleanup() noexcept
 
 	sys_log.notice("All CPU threads have been stopped. [+: %u]", +g_threads_created);
 
+	std::lock_guard lock(s_cpu_lock);
+
+	if (!s_suspend_stats.empty())
+	{
+		// Merge call sites whose file names are distinct copies of the same string
+		std::map<std::pair<std::string_view, u32>, suspend_site_stats> merged;
+
+		for (const auto& [site, stats] : s_suspend_stats)
+		{
+			auto& entry = merged[{site.first, site.second}];
+			entry.func = stats.func;
+			entry.works += stats.works;
+			entry.owned += stats.owned;
+			entry.threads += stats.threads;
+			entry.ticks += stats.ticks;
+			entry.max_ticks = std::max(entry.max_ticks, stats.max_ticks);
+		}
+
+		std::multimap<u64, decltype(merged)::const_pointer, std::greater<u64>> sorted;
+
+		for (const auto& entry : merged)
+		{
+			sorted.emplace(entry.second.ticks, &entry);
+		}
+
+		// Report raw TSC ticks if the frequency is unknown
+		const u64 tsc_freq = utils::get_tsc_freq();
+		const f64 scale = tsc_freq ? 1'000'000. / tsc_freq : 1.;
+		const std::string_view unit = tsc_freq ? "us" : " ticks";
+
+		std::string out;
+
+		for (const auto& [ticks, entry] : sorted)
+		{
+			const auto& [site, stats] = *entry;
+			const u64 owned = std::max<u64>(stats.owned, 1);
+
+			fmt::append(out, u8"\n\t⁂ %s:%u (%s): calls=%u (coalesced=%u), avg=%.1f%s, max=%.1f%s, threads=%.1f", site.first, site.second, stats.func,
+				stats.works, stats.works - stats.owned, ticks * scale / owned, unit, stats.max_ticks * scale, unit, static_cast<f64>(stats.threads) / owned);
+		}
+
+		sys_log.notice("suspend_all() statistics (by total pause time):%s", out);
+		s_suspend_stats.clear();
+	}
+
 	g_threads_deleted -= g_threads_created.load();
 	g_threads_created = 0;
 }
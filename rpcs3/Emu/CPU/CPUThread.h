@@ -70,6 +70,10 @@ public:
 	// Public thread state
 	atomic_bs_t<cpu_flag> state{cpu_flag::stop + cpu_flag::wait};
 
+	// Time accounting in TSC ticks (written by the thread itself, read without synchronization for diagnostics)
+	u64 start_tsc = 0; // Thread start
+	u64 suspended_time = 0; // Held by suspend_all operations of other threads
+
 	// Process thread state, return true if the checker must return
 	bool check_state() noexcept;
 
@@ -218,13 +222,16 @@ public:
 		// Next object in the linked list
 		suspend_work* next;
 
+		// Call site (for statistics)
+		std::source_location src_loc;
+
 		// Internal method
 		bool push(cpu_thread* _this) noexcept;
 	};
 
 	// Suspend all threads and execute op (may be executed by other thread than caller!)
 	template <u8 Prio = 0, typename F>
-	static auto suspend_all(cpu_thread* _this, std::initializer_list<void*> hints, F op)
+	static auto suspend_all(cpu_thread* _this, std::initializer_list<void*> hints, F op, std::source_location src_loc = std::source_location::current())
 	{
 		constexpr u8 prio = Prio > 3 ? 3 : Prio;
 
@@ -233,7 +240,7 @@ public:
 			suspend_work work{prio, false, false, ::size32(hints), hints.begin(), &op, nullptr, [](void* func, void*)
 			{
 				std::invoke(*static_cast<F*>(func));
-			}};
+			}, nullptr, src_loc};
 
 			work.push(_this);
 			return;
@@ -245,7 +252,7 @@ public:
 			suspend_work work{prio, false, false, ::size32(hints), hints.begin(), &op, &result, [](void* func, void* res_buf)
 			{
 				*static_cast<std::invoke_result_t<F>*>(res_buf) = std::invoke(*static_cast<F*>(func));
-			}};
+			}, nullptr, src_loc};
 
 			work.push(_this);
 			return result;
@@ -253,7 +260,7 @@ public:
 	}
 
 	template <u8 Prio = 0, typename F>
-	static suspend_work suspend_post(cpu_thread* /*_this*/, std::initializer_list<void*> hints, F& op)
+	static suspend_work suspend_post(cpu_thread* /*_this*/, std::initializer_list<void*> hints, F& op, std::source_location src_loc = std::source_location::current())
 	{
 		constexpr u8 prio = Prio > 3 ? 3 : Prio;
 
@@ -262,12 +269,12 @@ public:
 		return suspend_work{prio, false, true, ::size32(hints), hints.begin(), &op, nullptr, [](void* func, void*)
 		{
 			std::invoke(*static_cast<F*>(func));
-		}};
+		}, nullptr, src_loc};
 	}
 
 	// Push the workload only if threads are being suspended by suspend_all()
 	template <u8 Prio = 0, typename F>
-	static bool if_suspended(cpu_thread* _this, std::initializer_list<void*> hints, F op)
+	static bool if_suspended(cpu_thread* _this, std::initializer_list<void*> hints, F op, std::source_location src_loc = std::source_location::current())
 	{
 		constexpr u8 prio = Prio > 3 ? 3 : Prio;
 
@@ -277,7 +284,7 @@ public:
 			suspend_work work{prio, true, false, ::size32(hints), hints.begin(), &op, nullptr, [](void* func, void*)
 			{
 				std::invoke(*static_cast<F*>(func));
-			}};
+			}, nullptr, src_loc};
 
 			return work.push(_this);
 		}
@@ -98,6 +98,37 @@ struct alignas(16) spu_mfc_cmd
 	u32 eah;
 };
 
+// Merge MFC list elements following items[0] into its transfer while they are contiguous in both EA and LS, returns the number of merged elements
+// Only elements with 16-byte multiple sizes are merged, so copy loops working in 16-byte units never see a partial chunk
+// Stall-and-notify ends the run on the element which has it
+template <typename T>
+constexpr u32 mfc_list_coalesce(const T* items, u32 count, u32& size, u32 max_size, u32 ea_limit)
+{
+	const u32 addr = items[0].ea;
+
+	u32 merged = 0;
+
+	if (!size || size % 16 || addr >= ea_limit)
+	{
+		return 0;
+	}
+
+	while (merged + 1 < count && !(items[merged].sb & 0x80))
+	{
+		const u32 next_size = items[merged + 1].ts & 0x7fff;
+
+		if (!next_size || next_size % 16 || items[merged + 1].ea != addr + size || size + next_size > max_size || addr + size + next_size > ea_limit)
+		{
+			break;
+		}
+
+		size += next_size;
+		merged++;
+	}
+
+	return merged;
+}
+
 enum class spu_block_hash : u64;
 
 struct mfc_cmd_dump
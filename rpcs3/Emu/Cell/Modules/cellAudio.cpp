@@ -2,6 +2,7 @@
 #include "Emu/System.h"
 #include "Emu/system_config.h"
 #include "Emu/Audio/audio_utils.h"
+#include "Emu/Audio/audio_mix.h"
 #include "Emu/Cell/PPUModule.h"
 #include "Emu/Cell/timers.hpp"
 #include "Emu/Cell/lv2/sys_process.h"
@@ -154,7 +155,7 @@ audio_ringbuffer::audio_ringbuffer(cell_audio_config& _cfg)
 	}
 
 	// Configure resampler
-	resampler.set_params(static_cast<AudioChannelCnt>(cfg.audio_channels), static_cast<AudioFreq>(cfg.audio_sampling_rate));
+	resampler.set_params(static_cast<AudioChannelCnt>(cfg.audio_channels), static_cast<AudioFreq>(cfg.audio_sampling_rate), cfg.raw.time_stretching_resampler);
 	resampler.set_tempo(RESAMPLER_MAX_FREQ_VAL);
 
 	const f64 buffer_dur_mult = [&]()
@@ -617,6 +618,7 @@ namespace audio
 			.desired_buffer_duration = g_cfg.audio.desired_buffer_duration,
 			.enable_time_stretching = static_cast<bool>(g_cfg.audio.enable_time_stretching),
 			.time_stretching_threshold = g_cfg.audio.time_stretching_threshold,
+			.time_stretching_resampler = g_cfg.audio.time_stretching_resampler,
 			.convert_to_s16 = static_cast<bool>(g_cfg.audio.convert_to_s16),
 			.dump_to_file = static_cast<bool>(g_cfg.audio.dump_to_file),
 			.channel_layout = g_cfg.audio.channel_layout,
@@ -644,6 +646,7 @@ namespace audio
 				raw.buffering_enabled != new_raw.buffering_enabled ||
 				raw.time_stretching_threshold != new_raw.time_stretching_threshold ||
 				raw.enable_time_stretching != new_raw.enable_time_stretching ||
+				raw.time_stretching_resampler != new_raw.time_stretching_resampler ||
 				raw.convert_to_s16 != new_raw.convert_to_s16 ||
 				raw.renderer != new_raw.renderer ||
 				raw.dump_to_file != new_raw.dump_to_file)
@@ -1047,119 +1050,58 @@ void cell_audio_thread::mix(float* out_buffer, s32 offset)
 	// Reset out_buffer
 	std::memset(out_buffer, 0, out_buffer_sz * sizeof(float));
 
+	// Volume of each frame (only the first one is used when the port volume is constant)
+	std::array<f32, AUDIO_BUFFER_SAMPLES> volume;
+
 	// mixing
 	for (audio_port& port : ports)
 	{
 		if (port.state != audio_port_state::started) continue;
 
-		auto buf = port.get_vm_ptr(offset);
-
-		static constexpr float minus_3db = 0.707f; // value taken from https://www.dolby.com/us/en/technologies/a-guide-to-dolby-metadata.pdf
-		float m = master_volume;
+		const be_t<f32>* buf = port.get_vm_ptr(offset);
 
 		// part of cellAudioSetPortLevel functionality
 		// spread port volume changes over 13ms
-		auto step_volume = [master_volume, &m](audio_port& port)
-		{
-			const audio_port::level_set_t param = port.level_set.load();
+		audio_port::level_set_t param = port.level_set.load();
+		const bool ramp = param.inc != 0.0f;
 
-			if (param.inc != 0.0f)
+		if (ramp)
+		{
+			// Step the volume of the whole period at once
+			for (f32& m : volume)
 			{
-				port.level += param.inc;
-				const bool dec = param.inc < 0.0f;
-
-				if ((!dec && param.value - port.level <= 0.0f) || (dec && param.value - port.level >= 0.0f))
+				if (param.inc != 0.0f)
 				{
-					port.level = param.value;
-					port.level_set.compare_and_swap(param, { param.value, 0.0f });
+					port.level += param.inc;
+					const bool dec = param.inc < 0.0f;
+
+					if ((!dec && param.value - port.level <= 0.0f) || (dec && param.value - port.level >= 0.0f))
+					{
+						port.level = param.value;
+						port.level_set.compare_and_swap(param, { param.value, 0.0f });
+
+						// A new level set meanwhile is applied from the next period
+						param.inc = 0.0f;
+					}
 				}
-			}
 
-			m = port.level * master_volume;
-		};
+				m = port.level * master_volume;
+			}
+		}
+		else
+		{
+			volume[0] = port.level * master_volume;
+		}
 
 		if (port.num_channels == 2)
 		{
-			for (u32 out = 0, in = 0; out < out_buffer_sz; out += out_channels, in += 2)
-			{
-				step_volume(port);
-
-				const float left  = buf[in + 0] * m;
-				const float right = buf[in + 1] * m;
-
-				out_buffer[out + 0] += left;
-				out_buffer[out + 1] += right;
-			}
+			if (ramp) audio::mix_port<channels, downmix, 2, true>(out_buffer, buf, volume.data(), AUDIO_BUFFER_SAMPLES);
+			else audio::mix_port<channels, downmix, 2, false>(out_buffer, buf, volume.data(), AUDIO_BUFFER_SAMPLES);
 		}
 		else if (port.num_channels == 8)
 		{
-			for (u32 out = 0, in = 0; out < out_buffer_sz; out += out_channels, in += 8)
-			{
-				step_volume(port);
-
-				const float left       = buf[in + 0] * m;
-				const float right      = buf[in + 1] * m;
-				const float center     = buf[in + 2] * m;
-				const float low_freq   = buf[in + 3] * m;
-				const float side_left  = buf[in + 4] * m;
-				const float side_right = buf[in + 5] * m;
-				const float rear_left  = buf[in + 6] * m;
-				const float rear_right = buf[in + 7] * m;
-
-				if constexpr (downmix == AudioChannelCnt::STEREO)
-				{
-					// Don't mix in the lfe as per dolby specification and based on documentation
-					const float mid = center * 0.5f;
-					out_buffer[out + 0] += left * minus_3db + mid + side_left * 0.5f + rear_left * 0.5f;
-					out_buffer[out + 1] += right * minus_3db + mid + side_right * 0.5f + rear_right * 0.5f;
-				}
-				else if constexpr (downmix == AudioChannelCnt::SURROUND_5_1)
-				{
-					out_buffer[out + 0] += left;
-					out_buffer[out + 1] += right;
-
-					if constexpr (out_channels >= 6) // Only mix the surround channels into the output if surround output is configured
-					{
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-
-						if constexpr (out_channels == 6)
-						{
-							out_buffer[out + 4] += side_left + rear_left;
-							out_buffer[out + 5] += side_right + rear_right;
-						}
-						else // When using 7.1 ouput, out_buffer[out + 4] and out_buffer[out + 5] are the rear channels, so the side channels need to be mixed into [out + 6] and [out + 7]
-						{
-							out_buffer[out + 6] += side_left + rear_left;
-							out_buffer[out + 7] += side_right + rear_right;
-						}
-					}
-				}
-				else
-				{
-					out_buffer[out + 0] += left;
-					out_buffer[out + 1] += right;
-
-					if constexpr (out_channels >= 6) // Only mix the surround channels into the output if surround output is configured
-					{
-						out_buffer[out + 2] += center;
-						out_buffer[out + 3] += low_freq;
-
-						if constexpr (out_channels == 6)
-						{
-							out_buffer[out + 4] += side_left;
-							out_buffer[out + 5] += side_right;
-						}
-						else
-						{
-							out_buffer[out + 4] += rear_left;
-							out_buffer[out + 5] += rear_right;
-							out_buffer[out + 6] += side_left;
-							out_buffer[out + 7] += side_right;
-						}
-					}
-				}
-			}
+			if (ramp) audio::mix_port<channels, downmix, 8, true>(out_buffer, buf, volume.data(), AUDIO_BUFFER_SAMPLES);
+			else audio::mix_port<channels, downmix, 8, false>(out_buffer, buf, volume.data(), AUDIO_BUFFER_SAMPLES);
 		}
 		else
 		{
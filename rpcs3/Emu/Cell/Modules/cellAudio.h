@@ -210,6 +210,7 @@ struct cell_audio_config
 		s64 desired_buffer_duration = 0;
 		bool enable_time_stretching = false;
 		s64 time_stretching_threshold = 0;
+		audio_resampler_type time_stretching_resampler = audio_resampler_type::soundtouch;
 		bool convert_to_s16 = false;
 		bool dump_to_file = false;
 		audio_channel_layout channel_layout = audio_channel_layout::automatic;
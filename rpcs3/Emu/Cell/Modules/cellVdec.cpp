@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "Emu/IdManager.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/system_config.h"
+#include "Emu/Cell/timers.hpp"
 #include "Emu/Cell/PPUModule.h"
 #include "Emu/Cell/lv2/sys_sync.h"
 #include "Emu/Cell/lv2/sys_ppu_thread.h"
@@ -8,6 +10,7 @@
 #include "Emu/savestate_utils.hpp"
 #include "sysPrxForUser.h"
 #include "util/media_utils.h"
+#include "util/yuv_convert.hpp"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -38,6 +41,8 @@ extern "C"
 #include "Utilities/lockless.h"
 #include <variant>
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
+#include <map>
 
 std::mutex g_mutex_avcodec_open2;
 
@@ -141,6 +146,14 @@ struct vdec_cmd
 	CellVdecAuInfo au{};
 };
 
+// Guest attributes of an AU, attached to the pictures decoded from it
+struct vdec_au_info
+{
+	u64 cmd_id{};
+	u64 userdata{};
+	CellVdecPicAttr attr = CELL_VDEC_PICITEM_ATTR_NORMAL;
+};
+
 struct vdec_frame
 {
 	struct frame_dtor
@@ -206,6 +219,13 @@ struct vdec_context final
 	std::deque<vdec_frame> out_queue;
 	const u32 out_max = 60;
 
+	bool frame_threading = false;           // Pictures come out of the decoder up to (thread count - 1) AUs later
+	std::map<u64, vdec_au_info> pending_au; // AUs sent to the decoder whose pictures weren't received yet (frame threading only)
+
+	u64 decode_time_total = 0; // Time spent in the decoder during the current sequence (in microseconds)
+	u64 decode_time_max = 0;
+	u64 decode_count = 0;
+
 	atomic_t<s32> au_count{0};
 
 	lf_queue<vdec_cmd> in_cmd;
@@ -263,6 +283,26 @@ struct vdec_context final
 			fmt::throw_exception("avcodec_alloc_context3() failed (type=0x%x)", type);
 		}
 
+		// Slice threading splits each picture, frame threading decodes consecutive pictures in parallel
+		const s32 thread_count = g_cfg.core.vdec_threads ? static_cast<s32>(g_cfg.core.vdec_threads) : static_cast<s32>(std::clamp<u32>(utils::get_thread_count() / 2, 1, 4));
+
+		ctx->thread_count = thread_count;
+		ctx->thread_type = FF_THREAD_SLICE;
+
+		if (thread_count > 1 && g_cfg.core.vdec_frame_threading)
+		{
+#ifdef AV_CODEC_FLAG_COPY_OPAQUE
+			// The AU info has to travel with the packet because the pictures are delayed
+			ctx->flags |= AV_CODEC_FLAG_COPY_OPAQUE;
+			ctx->thread_type |= FF_THREAD_FRAME;
+			frame_threading = true;
+#else
+			cellVdec.warning("Frame threading is not supported by this version of FFmpeg, only slice threading will be used (type=0x%x)", type);
+#endif
+		}
+
+		cellVdec.notice("Opening video decoder (type=0x%x, threads=%d, frame_threading=%d)", type, thread_count, frame_threading);
+
 		AVDictionary* opts = nullptr;
 
 		std::lock_guard lock(g_mutex_avcodec_open2);
@@ -307,6 +347,196 @@ struct vdec_context final
 		return 0;
 	}
 
+	// Receive all pictures which are ready
+	void receive_frames(const vdec_cmd& cmd, const vdec_au_info& au, std::deque<vdec_frame>& decoded_frames)
+	{
+		while (!abort_decode && seq_id == cmd.seq_id)
+		{
+			// Keep receiving frames
+			vdec_frame frame;
+			frame.seq_id = cmd.seq_id;
+			frame.avf.reset(av_frame_alloc());
+
+			if (!frame.avf)
+			{
+				fmt::throw_exception("av_frame_alloc() failed (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd.seq_id, cmd.id);
+			}
+
+			if (int ret = avcodec_receive_frame(ctx, frame.avf.get()); ret < 0)
+			{
+				if (ret == AVERROR(EAGAIN) || ret == AVERROR(EOF))
+				{
+					break;
+				}
+
+				fmt::throw_exception("AU decoding error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd.seq_id, cmd.id, ret, utils::av_error_to_string(ret));
+			}
+
+			vdec_au_info info = au;
+
+#ifdef AV_CODEC_FLAG_COPY_OPAQUE
+			if (frame_threading)
+			{
+				// Use the info of the AU the picture was decoded from
+				if (const auto found = pending_au.find(reinterpret_cast<uptr>(frame->opaque)); found != pending_au.end())
+				{
+					info = found->second;
+					pending_au.erase(found);
+				}
+			}
+#endif
+
+			frame.cmd_id = info.cmd_id;
+
+#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(60, 31, 102)
+			const int ticks_per_frame = ctx->ticks_per_frame;
+#else
+			const int ticks_per_frame = (codec_desc->props & AV_CODEC_PROP_FIELDS) ? 2 : 1;
+#endif
+
+#if LIBAVUTIL_VERSION_INT < AV_VERSION_INT(58, 29, 100)
+			const bool is_interlaced = frame->interlaced_frame != 0;
+#else
+			const bool is_interlaced = !!(frame->flags & AV_FRAME_FLAG_INTERLACED);
+#endif
+
+			if (is_interlaced)
+			{
+				// NPEB01838, NPUB31260
+				cellVdec.todo("Interlaced frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd.seq_id, cmd.id);
+			}
+
+			if (frame->repeat_pict)
+			{
+				fmt::throw_exception("Repeated frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d, repear_pict=0x%x)", handle, cmd.seq_id, cmd.id, frame->repeat_pict);
+			}
+
+			if (frame->pts != smin)
+			{
+				next_pts = frame->pts;
+			}
+
+			if (frame->pkt_dts != smin)
+			{
+				next_dts = frame->pkt_dts;
+			}
+
+			frame.pts = next_pts;
+			frame.dts = next_dts;
+			frame.userdata = info.userdata;
+			frame.attr = info.attr;
+
+			u64 amend = 0;
+
+			if (frc_set)
+			{
+				switch (frc_set)
+				{
+				case CELL_VDEC_FRC_24000DIV1001: amend = 1001 * 90000 / 24000; break;
+				case CELL_VDEC_FRC_24: amend = 90000 / 24; break;
+				case CELL_VDEC_FRC_25: amend = 90000 / 25; break;
+				case CELL_VDEC_FRC_30000DIV1001: amend = 1001 * 90000 / 30000; break;
+				case CELL_VDEC_FRC_30: amend = 90000 / 30; break;
+				case CELL_VDEC_FRC_50: amend = 90000 / 50; break;
+				case CELL_VDEC_FRC_60000DIV1001: amend = 1001 * 90000 / 60000; break;
+				case CELL_VDEC_FRC_60: amend = 90000 / 60; break;
+				default:
+				{
+					fmt::throw_exception("Invalid frame rate code set (handle=0x%x, seq_id=%d, cmd_id=%d, frc=0x%x)", handle, cmd.seq_id, cmd.id, frc_set);
+				}
+				}
+
+				frame.frc = frc_set;
+			}
+			else if (ctx->time_base.den && ctx->time_base.num)
+			{
+				const auto freq = 1. * ctx->time_base.den / ctx->time_base.num / ticks_per_frame;
+
+				frame.frc = freq_to_framerate_code(freq);
+				if (frame.frc)
+				{
+					amend = u64{90000} * ctx->time_base.num * ticks_per_frame / ctx->time_base.den;
+				}
+			}
+			else if (ctx->framerate.den && ctx->framerate.num)
+			{
+				const auto freq = ctx->framerate.num / static_cast<f64>(ctx->framerate.den);
+
+				frame.frc = freq_to_framerate_code(freq);
+				if (frame.frc)
+				{
+					amend = u64{90000} * ctx->framerate.den / ctx->framerate.num;
+				}
+			}
+
+			if (amend == 0 || frame.frc == 0)
+			{
+				if (log_time_base.den != ctx->time_base.den || log_time_base.num != ctx->time_base.num || log_framerate.den != ctx->framerate.den || log_framerate.num != ctx->framerate.num)
+				{
+					cellVdec.error("Invalid frequency (handle=0x%x, seq_id=%d, cmd_id=%d, timebase=%d/%d, tpf=%d framerate=%d/%d)", handle, cmd.seq_id, cmd.id, ctx->time_base.num, ctx->time_base.den, ticks_per_frame, ctx->framerate.num, ctx->framerate.den);
+					log_time_base = ctx->time_base;
+					log_framerate = ctx->framerate;
+				}
+
+				// Hack
+				amend = u64{90000} / 30;
+				frame.frc = CELL_VDEC_FRC_30;
+			}
+
+			next_pts += amend;
+			next_dts += amend;
+
+			cellVdec.trace("Got picture (handle=0x%x, seq_id=%d, cmd_id=%d, pts=0x%llx[0x%llx], dts=0x%llx[0x%llx])", handle, cmd.seq_id, cmd.id, frame.pts, frame->pts, frame.dts, frame->pkt_dts);
+
+			decoded_frames.push_back(std::move(frame));
+		}
+	}
+
+	// Push decoded pictures to the picture queue, waiting for free space
+	void output_frames(ppu_thread& ppu, u32 vid, const vdec_cmd& cmd, std::deque<vdec_frame>& decoded_frames)
+	{
+		while (!decoded_frames.empty() && seq_id == cmd.seq_id)
+		{
+			// Wait until there is free space in the image queue.
+			// Do this after pushing the frame to the queue. That way the game can consume the frame and we can move on.
+			u32 elapsed = 0;
+			while (thread_ctrl::state() != thread_state::aborting && !abort_decode && seq_id == cmd.seq_id)
+			{
+				{
+					std::lock_guard lock{mutex};
+
+					if (out_queue.size() <= out_max)
+					{
+						break;
+					}
+				}
+
+				thread_ctrl::wait_for(10000);
+
+				if (elapsed++ >= 500) // 5 seconds
+				{
+					cellVdec.error("Video au decode has been waiting for a consumer for 5 seconds. (handle=0x%x, seq_id=%d, cmd_id=%d, queue_size=%d)", handle, cmd.seq_id, cmd.id, out_queue.size());
+					elapsed = 0;
+				}
+			}
+
+			if (thread_ctrl::state() == thread_state::aborting || abort_decode || seq_id != cmd.seq_id)
+			{
+				break;
+			}
+
+			{
+				std::lock_guard lock{mutex};
+				out_queue.push_back(std::move(decoded_frames.front()));
+				decoded_frames.pop_front();
+			}
+
+			cellVdec.trace("Sending CELL_VDEC_MSG_TYPE_PICOUT (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd.seq_id, cmd.id);
+			cb_func(ppu, vid, CELL_VDEC_MSG_TYPE_PICOUT, CELL_OK, cb_arg);
+			lv2_obj::sleep(ppu);
+		}
+	}
+
 	void exec(ppu_thread& ppu, u32 vid)
 	{
 		perf_meter<"VDEC"_u32> perf0;
@@ -362,6 +592,11 @@ struct vdec_context final
 				next_pts = 0;
 				next_dts = 0;
 
+				pending_au.clear();
+				decode_time_total = 0;
+				decode_time_max = 0;
+				decode_count = 0;
+
 				abort_decode = false;
 				is_running = true;
 				break;
@@ -370,6 +605,25 @@ struct vdec_context final
 			{
 				cellVdec.trace("End sequence... (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
 
+				if (frame_threading && !abort_decode && seq_id == cmd->seq_id)
+				{
+					// Drain the pictures still held by the decoder threads
+					if (int ret = avcodec_send_packet(ctx, nullptr); ret < 0 && ret != AVERROR_EOF)
+					{
+						fmt::throw_exception("AU draining error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
+					}
+
+					std::deque<vdec_frame> decoded_frames;
+					receive_frames(*cmd, {cmd->id}, decoded_frames);
+					output_frames(ppu, vid, *cmd, decoded_frames);
+				}
+
+				if (decode_count)
+				{
+					cellVdec.notice("Sequence decode time: %d AUs, %.3f ms on average, %.3f ms at most (handle=0x%x, seq_id=%d, threads=%d, frame_threading=%d)",
+						decode_count, decode_time_total / 1000. / decode_count, decode_time_max / 1000., handle, cmd->seq_id, ctx->thread_count, frame_threading);
+				}
+
 				{
 					std::lock_guard lock{mutex};
 					seq_state = sequence_state::dormant;
@@ -421,136 +675,34 @@ struct vdec_context final
 				{
 					cellVdec.trace("AU decoding: handle=0x%x, seq_id=%d, cmd_id=%d, size=0x%x, pts=0x%llx, dts=0x%llx, userdata=0x%llx", handle, cmd->seq_id, cmd->id, au_size, au_pts, au_dts, au_usrd);
 
-					if (int ret = avcodec_send_packet(ctx, &packet); ret < 0)
-					{
-						fmt::throw_exception("AU queuing error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
-					}
+					perf_meter<"VDEC_AU"_u64> perf1;
+					const u64 decode_start = get_system_time();
 
-					while (!abort_decode && seq_id == cmd->seq_id)
+#ifdef AV_CODEC_FLAG_COPY_OPAQUE
+					if (frame_threading)
 					{
-						// Keep receiving frames
-						vdec_frame frame;
-						frame.seq_id = cmd->seq_id;
-						frame.cmd_id = cmd->id;
-						frame.avf.reset(av_frame_alloc());
+						packet.opaque = reinterpret_cast<void*>(static_cast<uptr>(cmd->id));
+						pending_au.emplace(cmd->id, vdec_au_info{cmd->id, au_usrd, attr});
 
-						if (!frame.avf)
+						// Skipped pictures never come out, forget about the oldest AUs
+						while (pending_au.size() > out_max)
 						{
-							fmt::throw_exception("av_frame_alloc() failed (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
-						}
-
-						if (int ret = avcodec_receive_frame(ctx, frame.avf.get()); ret < 0)
-						{
-							if (ret == AVERROR(EAGAIN) || ret == AVERROR(EOF))
-							{
-								break;
-							}
-
-							fmt::throw_exception("AU decoding error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
+							pending_au.erase(pending_au.begin());
 						}
-
-#if LIBAVCODEC_VERSION_INT < AV_VERSION_INT(60, 31, 102)
-						const int ticks_per_frame = ctx->ticks_per_frame;
-#else
-						const int ticks_per_frame = (codec_desc->props & AV_CODEC_PROP_FIELDS) ? 2 : 1;
-#endif
-
-#if LIBAVUTIL_VERSION_INT < AV_VERSION_INT(58, 29, 100)
-						const bool is_interlaced = frame->interlaced_frame != 0;
-#else
-						const bool is_interlaced = !!(frame->flags & AV_FRAME_FLAG_INTERLACED);
+					}
 #endif
 
-						if (is_interlaced)
-						{
-							// NPEB01838, NPUB31260
-							cellVdec.todo("Interlaced frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
-						}
-
-						if (frame->repeat_pict)
-						{
-							fmt::throw_exception("Repeated frames not supported (handle=0x%x, seq_id=%d, cmd_id=%d, repear_pict=0x%x)", handle, cmd->seq_id, cmd->id, frame->repeat_pict);
-						}
-
-						if (frame->pts != smin)
-						{
-							next_pts = frame->pts;
-						}
-
-						if (frame->pkt_dts != smin)
-						{
-							next_dts = frame->pkt_dts;
-						}
-
-						frame.pts = next_pts;
-						frame.dts = next_dts;
-						frame.userdata = au_usrd;
-						frame.attr = attr;
-
-						u64 amend = 0;
-
-						if (frc_set)
-						{
-							switch (frc_set)
-							{
-							case CELL_VDEC_FRC_24000DIV1001: amend = 1001 * 90000 / 24000; break;
-							case CELL_VDEC_FRC_24: amend = 90000 / 24; break;
-							case CELL_VDEC_FRC_25: amend = 90000 / 25; break;
-							case CELL_VDEC_FRC_30000DIV1001: amend = 1001 * 90000 / 30000; break;
-							case CELL_VDEC_FRC_30: amend = 90000 / 30; break;
-							case CELL_VDEC_FRC_50: amend = 90000 / 50; break;
-							case CELL_VDEC_FRC_60000DIV1001: amend = 1001 * 90000 / 60000; break;
-							case CELL_VDEC_FRC_60: amend = 90000 / 60; break;
-							default:
-							{
-								fmt::throw_exception("Invalid frame rate code set (handle=0x%x, seq_id=%d, cmd_id=%d, frc=0x%x)", handle, cmd->seq_id, cmd->id, frc_set);
-							}
-							}
-
-							frame.frc = frc_set;
-						}
-						else if (ctx->time_base.den && ctx->time_base.num)
-						{
-							const auto freq = 1. * ctx->time_base.den / ctx->time_base.num / ticks_per_frame;
-
-							frame.frc = freq_to_framerate_code(freq);
-							if (frame.frc)
-							{
-								amend = u64{90000} * ctx->time_base.num * ticks_per_frame / ctx->time_base.den;
-							}
-						}
-						else if (ctx->framerate.den && ctx->framerate.num)
-						{
-							const auto freq = ctx->framerate.num / static_cast<f64>(ctx->framerate.den);
-
-							frame.frc = freq_to_framerate_code(freq);
-							if (frame.frc)
-							{
-								amend = u64{90000} * ctx->framerate.den / ctx->framerate.num;
-							}
-						}
-
-						if (amend == 0 || frame.frc == 0)
-						{
-							if (log_time_base.den != ctx->time_base.den || log_time_base.num != ctx->time_base.num || log_framerate.den != ctx->framerate.den || log_framerate.num != ctx->framerate.num)
-							{
-								cellVdec.error("Invalid frequency (handle=0x%x, seq_id=%d, cmd_id=%d, timebase=%d/%d, tpf=%d framerate=%d/%d)", handle, cmd->seq_id, cmd->id, ctx->time_base.num, ctx->time_base.den, ticks_per_frame, ctx->framerate.num, ctx->framerate.den);
-								log_time_base = ctx->time_base;
-								log_framerate = ctx->framerate;
-							}
-
-							// Hack
-							amend = u64{90000} / 30;
-							frame.frc = CELL_VDEC_FRC_30;
-						}
-
-						next_pts += amend;
-						next_dts += amend;
+					if (int ret = avcodec_send_packet(ctx, &packet); ret < 0)
+					{
+						fmt::throw_exception("AU queuing error (handle=0x%x, seq_id=%d, cmd_id=%d, error=0x%x): %s", handle, cmd->seq_id, cmd->id, ret, utils::av_error_to_string(ret));
+					}
 
-						cellVdec.trace("Got picture (handle=0x%x, seq_id=%d, cmd_id=%d, pts=0x%llx[0x%llx], dts=0x%llx[0x%llx])", handle, cmd->seq_id, cmd->id, frame.pts, frame->pts, frame.dts, frame->pkt_dts);
+					receive_frames(*cmd, {cmd->id, au_usrd, attr}, decoded_frames);
 
-						decoded_frames.push_back(std::move(frame));
-					}
+					const u64 decode_time = get_system_time() - decode_start;
+					decode_time_total += decode_time;
+					decode_time_max = std::max(decode_time_max, decode_time);
+					decode_count++;
 				}
 
 				if (thread_ctrl::state() != thread_state::aborting)
@@ -562,46 +714,7 @@ struct vdec_context final
 					cb_func(ppu, vid, CELL_VDEC_MSG_TYPE_AUDONE, CELL_OK, cb_arg);
 					lv2_obj::sleep(ppu);
 
-					while (!decoded_frames.empty() && seq_id == cmd->seq_id)
-					{
-						// Wait until there is free space in the image queue.
-						// Do this after pushing the frame to the queue. That way the game can consume the frame and we can move on.
-						u32 elapsed = 0;
-						while (thread_ctrl::state() != thread_state::aborting && !abort_decode && seq_id == cmd->seq_id)
-						{
-							{
-								std::lock_guard lock{mutex};
-
-								if (out_queue.size() <= out_max)
-								{
-									break;
-								}
-							}
-
-							thread_ctrl::wait_for(10000);
-
-							if (elapsed++ >= 500) // 5 seconds
-							{
-								cellVdec.error("Video au decode has been waiting for a consumer for 5 seconds. (handle=0x%x, seq_id=%d, cmd_id=%d, queue_size=%d)", handle, cmd->seq_id, cmd->id, out_queue.size());
-								elapsed = 0;
-							}
-						}
-
-						if (thread_ctrl::state() == thread_state::aborting || abort_decode || seq_id != cmd->seq_id)
-						{
-							break;
-						}
-
-						{
-							std::lock_guard lock{mutex};
-							out_queue.push_back(std::move(decoded_frames.front()));
-							decoded_frames.pop_front();
-						}
-
-						cellVdec.trace("Sending CELL_VDEC_MSG_TYPE_PICOUT (handle=0x%x, seq_id=%d, cmd_id=%d)", handle, cmd->seq_id, cmd->id);
-						cb_func(ppu, vid, CELL_VDEC_MSG_TYPE_PICOUT, CELL_OK, cb_arg);
-						lv2_obj::sleep(ppu);
-					}
+					output_frames(ppu, vid, *cmd, decoded_frames);
 				}
 
 				if (abort_decode || seq_id != cmd->seq_id)
@@ -1346,12 +1459,10 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 
 		AVPixelFormat out_f = AV_PIX_FMT_YUV420P;
 
-		std::unique_ptr<u8[]> alpha_plane;
-
 		switch (const u32 type = format->formatType)
 		{
-		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; alpha_plane.reset(new u8[w * h]); break;
-		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; alpha_plane.reset(new u8[w * h]); break;
+		case CELL_VDEC_PICFMT_ARGB32_ILV: out_f = AV_PIX_FMT_ARGB; break;
+		case CELL_VDEC_PICFMT_RGBA32_ILV: out_f = AV_PIX_FMT_RGBA; break;
 		case CELL_VDEC_PICFMT_UYVY422_ILV: out_f = AV_PIX_FMT_UYVY422; break;
 		case CELL_VDEC_PICFMT_YUV420_PLANAR: out_f = AV_PIX_FMT_YUV420P; break;
 		default:
@@ -1360,14 +1471,7 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 		}
 		}
 
-		// TODO: color matrix
-
-		if (alpha_plane)
-		{
-			std::memset(alpha_plane.get(), format->alpha, w * h);
-		}
-
-		AVPixelFormat in_f = AV_PIX_FMT_YUV420P;
+		const bool is_rgb = out_f == AV_PIX_FMT_ARGB || out_f == AV_PIX_FMT_RGBA;
 
 		switch (frame->format)
 		{
@@ -1375,35 +1479,46 @@ error_code cellVdecGetPictureExt(ppu_thread& ppu, u32 handle, vm::cptr<CellVdecP
 			cellVdec.error("cellVdecGetPictureExt: experimental AVPixelFormat (handle=0x%x, seq_id=%d, cmd_id=%d, format=%d). This may cause suboptimal video quality.", handle, frame.seq_id, frame.cmd_id, frame->format);
 			[[fallthrough]];
 		case AV_PIX_FMT_YUV420P:
-			in_f = alpha_plane ? AV_PIX_FMT_YUVA420P : static_cast<AVPixelFormat>(frame->format);
 			break;
 		default:
 			fmt::throw_exception("cellVdecGetPictureExt: Unknown frame format (%d)", frame->format);
 		}
 
-		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, in_f=%d, out_f=%d, alpha_plane=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +in_f, +out_f, !!alpha_plane, format->alpha, format->colorMatrixType);
-
-		vdec->sws = sws_getCachedContext(vdec->sws, w, h, in_f, w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
-
-		u8* in_data[4] = { frame->data[0], frame->data[1], frame->data[2], alpha_plane.get() };
-		int in_line[4] = { frame->linesize[0], frame->linesize[1], frame->linesize[2], w * 1 };
-		u8* out_data[4] = { outBuff.get_ptr() };
-		int out_line[4] = { w * 4 }; // RGBA32 or ARGB32
+		cellVdec.trace("cellVdecGetPictureExt: handle=0x%x, seq_id=%d, cmd_id=%d, w=%d, h=%d, frameFormat=%d, formatType=%d, out_f=%d, alpha=%d, colorMatrixType=%d", handle, frame.seq_id, frame.cmd_id, w, h, frame->format, format->formatType, +out_f, format->alpha, format->colorMatrixType);
 
 		// TODO:
 		// It's possible that we need to align the pitch to 128 here.
 		// PS HOME seems to rely on this somehow in certain cases.
 
-		if (!alpha_plane)
+		if (is_rgb)
 		{
-			// YUV420P or UYVY422
-			out_data[1] = out_data[0] + w * h;
-			out_data[2] = out_data[0] + w * h * 5 / 4;
+			// Convert straight into the guest buffer, the alpha is constant
+			utils::yuv_to_rgb32_params params{};
+			params.matrix = format->colorMatrixType == CELL_VDEC_COLOR_MATRIX_TYPE_BT709 ? utils::yuv_color_matrix::bt709 : utils::yuv_color_matrix::bt601;
+			params.full_range = frame->format == AV_PIX_FMT_YUVJ420P;
+			params.layout = out_f == AV_PIX_FMT_ARGB ? utils::rgb32_layout::argb : utils::rgb32_layout::rgba;
+			params.alpha = format->alpha;
 
-			if (const int ret = av_image_fill_linesizes(out_line, out_f, w); ret < 0)
-			{
-				fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
-			}
+			const utils::yuv420_planes planes{ frame->data[0], frame->data[1], frame->data[2], static_cast<u32>(frame->linesize[0]), static_cast<u32>(frame->linesize[1]) };
+
+			utils::convert_yuv420_to_rgb32(planes, outBuff.get_ptr(), w * 4, w, h, params, static_cast<u32>(g_cfg.core.vdec_color_conversion_threads));
+			return CELL_OK;
+		}
+
+		// YUV420P or UYVY422
+		vdec->sws = sws_getCachedContext(vdec->sws, w, h, static_cast<AVPixelFormat>(frame->format), w, h, out_f, SWS_POINT, nullptr, nullptr, nullptr);
+
+		u8* in_data[4] = { frame->data[0], frame->data[1], frame->data[2] };
+		int in_line[4] = { frame->linesize[0], frame->linesize[1], frame->linesize[2] };
+		u8* out_data[4] = { outBuff.get_ptr() };
+		int out_line[4] = {};
+
+		out_data[1] = out_data[0] + w * h;
+		out_data[2] = out_data[0] + w * h * 5 / 4;
+
+		if (const int ret = av_image_fill_linesizes(out_line, out_f, w); ret < 0)
+		{
+			fmt::throw_exception("cellVdecGetPictureExt: av_image_fill_linesizes failed (handle=0x%x, seq_id=%d, cmd_id=%d, ret=0x%x): %s", handle, frame.seq_id, frame.cmd_id, ret, utils::av_error_to_string(ret));
 		}
 
 		sws_scale(vdec->sws, in_data, in_line, 0, h, out_data, out_line);
@@ -1,6 +1,8 @@
 #include "stdafx.h"
 #include "Emu/IdManager.h"
 #include "Emu/Cell/PPUModule.h"
+#include "Emu/system_config.h"
+#include "util/yuv_convert.hpp"
 
 #ifdef _MSC_VER
 #pragma warning(push, 0)
@@ -270,6 +272,21 @@ error_code cellVpostExec(u32 handle, vm::cptr<u8> inPicBuff, vm::cptr<CellVpostC
 	picInfo->reserved1 = 0;
 	picInfo->reserved2 = 0;
 
+	if (ow == w && oh == h)
+	{
+		// No scaling, convert straight into the output buffer
+		utils::yuv_to_rgb32_params params{};
+		params.matrix = ctrlParam->inColorMatrix == CELL_VPOST_COLOR_MATRIX_BT709 ? utils::yuv_color_matrix::bt709 : utils::yuv_color_matrix::bt601;
+		params.full_range = ctrlParam->inQuantRange == CELL_VPOST_QUANT_RANGE_FULL;
+		params.layout = utils::rgb32_layout::rgba;
+		params.alpha = ctrlParam->outAlpha;
+
+		const utils::yuv420_planes planes{ &inPicBuff[0], &inPicBuff[w * h], &inPicBuff[w * h * 5 / 4], w, w / 2 };
+
+		utils::convert_yuv420_to_rgb32(planes, outPicBuff.get_ptr(), ow * 4, w, h, params, static_cast<u32>(g_cfg.core.vdec_color_conversion_threads));
+		return CELL_OK;
+	}
+
 	//u64 stamp0 = get_guest_system_time();
 	std::unique_ptr<u8[]> pA(new u8[w*h]);
 
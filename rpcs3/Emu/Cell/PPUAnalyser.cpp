@@ -6,9 +6,17 @@
 #include "PPUOpcodes.h"
 #include "PPUThread.h"
 
+#include "Emu/system_config.h"
+#include "Emu/system_utils.hpp"
+#include "Crypto/sha1.h"
+#include "Utilities/File.h"
+#include "Utilities/Thread.h"
+
 #include <unordered_set>
+#include <memory_resource>
 #include "util/yaml.hpp"
 #include "util/asm.hpp"
+#include "util/sysinfo.hpp"
 
 LOG_CHANNEL(ppu_validator);
 
@@ -819,6 +827,198 @@ struct reg_state_t
 
 static constexpr reg_state_t s_reg_const_0{ 0, 1 };
 
+// Analysis results are cached by a hash of everything the analyser depends on (bump the version when its results change)
+constexpr u32 c_ppu_analysis_cache_magic = "PPUA"_u32;
+constexpr u32 c_ppu_analysis_cache_version = 2;
+
+static std::string ppu_get_analysis_cache_path(const ppu_module<lv2_obj>& mod, u32 lib_toc, u32 entry, u32 sec_end, const std::vector<u32>& applied, const std::vector<u32>& exported_funcs)
+{
+	if (mod.path.empty() || !g_cfg.core.ppu_analysis_cache)
+	{
+		return {};
+	}
+
+	sha1_context ctx;
+	u8 key[20]{};
+	sha1_starts(&ctx);
+
+	const auto hash = [&](const auto& value)
+	{
+		sha1_update(&ctx, reinterpret_cast<const u8*>(&value), sizeof(value));
+	};
+
+	const auto hash_vector = [&](const auto& vec)
+	{
+		hash(vec.size());
+		sha1_update(&ctx, reinterpret_cast<const u8*>(vec.data()), vec.size() * sizeof(vec[0]));
+	};
+
+	hash(c_ppu_analysis_cache_version);
+	hash(lib_toc);
+	hash(entry);
+	hash(sec_end);
+	hash(mod.is_relocatable);
+	hash(mod.funcs.size());
+
+	for (const auto& seg : mod.segs)
+	{
+		hash(seg.addr);
+		hash(seg.size);
+		hash(seg.type);
+		hash(seg.flags);
+
+		if (seg.size && seg.ptr)
+		{
+			sha1_update(&ctx, static_cast<const u8*>(seg.ptr), seg.size);
+		}
+	}
+
+	for (const auto& sec : mod.secs)
+	{
+		hash(sec.addr);
+		hash(sec.size);
+		hash(sec.type);
+		hash(sec.flags);
+	}
+
+	hash_vector(mod.relocs);
+	hash_vector(applied);
+	hash_vector(exported_funcs);
+
+	for (const auto& [addr, states] : mod.stub_addr_to_constant_state_of_registers)
+	{
+		hash(addr);
+		hash(states.size());
+
+		for (const auto& [mask, value] : states)
+		{
+			hash(mask.mask);
+			hash(value);
+		}
+	}
+
+	sha1_finish(&ctx, key);
+
+	return fmt::format("%sppu_analysis/%s-%s.dat", rpcs3::utils::get_cache_dir(mod.path), mod.path.substr(mod.path.find_last_of('/') + 1), fmt::base57(key));
+}
+
+using ppu_stub_reg_states = std::map<u32, std::vector<std::pair<ppua_reg_mask_t, u64>>>;
+
+static bool ppu_load_analysis_cache(const std::string& path, std::vector<ppu_function>& funcs, ppu_stub_reg_states& stub_states)
+{
+	const fs::file file(path);
+
+	if (!file)
+	{
+		return false;
+	}
+
+	const std::vector<u32> data = file.to_vector<u32>();
+
+	if (data.size() < 3 || data[0] != c_ppu_analysis_cache_magic || data[1] != c_ppu_analysis_cache_version)
+	{
+		ppu_log.warning("Ignoring invalid PPU analysis cache: %s", path);
+		return false;
+	}
+
+	// Function: addr, toc, size, block count, then (addr, size) for every block
+	std::vector<ppu_function> result(data[2]);
+	usz pos = 3;
+
+	for (ppu_function& func : result)
+	{
+		if (data.size() - pos < 4 || (data.size() - pos - 4) / 2 < data[pos + 3])
+		{
+			ppu_log.warning("Ignoring truncated PPU analysis cache: %s", path);
+			return false;
+		}
+
+		func.addr = data[pos++];
+		func.toc = data[pos++];
+		func.size = data[pos++];
+
+		for (u32 i = 0, count = data[pos++]; i < count; i++, pos += 2)
+		{
+			func.blocks.emplace_hint(func.blocks.end(), data[pos], data[pos + 1]);
+		}
+	}
+
+	// Import stub register states found by the analysis: stub count, then addr, state count, then (mask, value) as 64-bit halves for every state
+	if (data.size() - pos < 1)
+	{
+		ppu_log.warning("Ignoring truncated PPU analysis cache: %s", path);
+		return false;
+	}
+
+	ppu_stub_reg_states states;
+
+	for (u32 i = 0, stubs = data[pos++]; i < stubs; i++)
+	{
+		if (data.size() - pos < 2 || (data.size() - pos - 2) / 4 < data[pos + 1])
+		{
+			ppu_log.warning("Ignoring truncated PPU analysis cache: %s", path);
+			return false;
+		}
+
+		auto& stub = states[data[pos]];
+		const u32 count = data[pos + 1];
+		pos += 2;
+
+		for (u32 j = 0; j < count; j++, pos += 4)
+		{
+			stub.emplace_back(ppua_reg_mask_t{data[pos] | u64{data[pos + 1]} << 32}, data[pos + 2] | u64{data[pos + 3]} << 32);
+		}
+	}
+
+	for (auto& [addr, stub] : states)
+	{
+		stub_states[addr] = std::move(stub);
+	}
+
+	funcs.insert(funcs.end(), std::make_move_iterator(result.begin()), std::make_move_iterator(result.end()));
+	return true;
+}
+
+static void ppu_save_analysis_cache(const std::string& path, std::span<const ppu_function> funcs, const ppu_stub_reg_states& stub_states)
+{
+	std::vector<u32> data{c_ppu_analysis_cache_magic, c_ppu_analysis_cache_version, ::size32(funcs)};
+
+	for (const ppu_function& func : funcs)
+	{
+		data.insert(data.end(), {func.addr, func.toc, func.size, ::size32(func.blocks)});
+
+		for (const auto& [addr, size] : func.blocks)
+		{
+			data.insert(data.end(), {addr, size});
+		}
+	}
+
+	data.push_back(::size32(stub_states));
+
+	for (const auto& [addr, states] : stub_states)
+	{
+		data.insert(data.end(), {addr, ::size32(states)});
+
+		for (const auto& [mask, value] : states)
+		{
+			data.insert(data.end(), {static_cast<u32>(mask.mask), static_cast<u32>(mask.mask >> 32), static_cast<u32>(value), static_cast<u32>(value >> 32)});
+		}
+	}
+
+	if (!fs::create_path(fs::get_parent_dir(path)))
+	{
+		ppu_log.error("Failed to create PPU analysis cache directory: %s (%s)", fs::get_parent_dir(path), fs::g_tls_error);
+		return;
+	}
+
+	fs::pending_file file(path);
+
+	if (!file.file || file.file.write(data.data(), data.size() * sizeof(u32)) != data.size() * sizeof(u32) || !file.commit())
+	{
+		ppu_log.error("Failed to save PPU analysis cache: %s (%s)", path, fs::g_tls_error);
+	}
+}
+
 template <>
 bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, const std::vector<u32>& applied, const std::vector<u32>& exported_funcs, std::function<bool()> check_aborted)
 {
@@ -827,6 +1027,16 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 		return false;
 	}
 
+	// Reuse the results of a previous boot if nothing has changed
+	const std::string cache_path = ppu_get_analysis_cache_path(*this, lib_toc, entry, sec_end, applied, exported_funcs);
+	const usz funcs_begin = funcs.size();
+
+	if (!cache_path.empty() && ppu_load_analysis_cache(cache_path, funcs, stub_addr_to_constant_state_of_registers))
+	{
+		ppu_log.notice("Loaded PPU analysis of '%s' from cache (%zu functions)", name, funcs.size() - funcs_begin);
+		return true;
+	}
+
 	// Assume first segment is executable
 	const u32 start = segs[0].addr;
 
@@ -854,12 +1064,15 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 		u32 trampoline = 0;
 		bs_t<ppu_attr> attr{};
 
-		std::set<u32> callers{};
+		utils::flat_set<u32> callers{};
 	};
 
+	// Arena for node-based containers below, released at once when the analysis ends
+	std::pmr::monotonic_buffer_resource arena(0x10000);
+
 	// Known functions
-	std::map<u32, ppu_function_ext> fmap;
-	std::set<u32> known_functions;
+	std::pmr::map<u32, ppu_function_ext> fmap(&arena);
+	utils::flat_set<u32> known_functions;
 
 	// Function analysis workload
 	std::vector<std::reference_wrapper<ppu_function_ext>> func_queue;
@@ -867,7 +1080,7 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 	// Known references (within segs, addr and value alignment = 4)
 	// For seg0, must be valid code
 	// Value is a sample of an address that refernces it
-	std::map<u32, u32> addr_heap;
+	std::pmr::map<u32, u32> addr_heap(&arena);
 
 	if (entry)
 	{
@@ -1058,39 +1271,90 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 
 	// Find references indiscriminately
 	// For seg0, must be valid code
+	// Segments are split into fixed ranges scanned in parallel, results are merged in address order
+	struct ref_range
+	{
+		u32 addr;
+		u32 last; // Address of the last word
+		std::vector<std::pair<u32, u32>> refs{};
+	};
+
+	std::vector<ref_range> ref_ranges;
+
 	for (const auto& seg : segs)
 	{
 		if (seg.size < 4) continue;
 
-		vm::cptr<u32> _ptr = vm::cast(seg.addr);
-		const vm::cptr<void> seg_end = vm::cast(seg.addr + seg.size - 4);
-		auto ptr = get_ptr<u32>(_ptr);
+		constexpr u32 range_size = 0x40000;
 
-		for (; _ptr <= seg_end; advance(_ptr, ptr, 1))
+		for (u32 addr = seg.addr, last = seg.addr + seg.size - 4;; addr += range_size)
 		{
-			const u32 value = *ptr;
+			ref_ranges.push_back({addr, std::min<u32>(addr + range_size - 4, last)});
 
-			if (value % 4 || !verify_ref(_ptr.addr()))
+			if (last - addr < range_size)
 			{
-				continue;
+				break;
 			}
+		}
+	}
+
+	atomic_t<usz> ref_range_index = 0;
+
+	const auto find_refs = [&]()
+	{
+		for (usz index; (index = ref_range_index++) < ref_ranges.size();)
+		{
+			ref_range& range = ref_ranges[index];
+
+			vm::cptr<u32> _ptr = vm::cast(range.addr);
+			const vm::cptr<void> seg_end = vm::cast(range.last);
+			auto ptr = get_ptr<u32>(_ptr);
 
-			for (const auto& _seg : segs)
+			for (; _ptr <= seg_end; advance(_ptr, ptr, 1))
 			{
-				if (!_seg.size) continue;
+				const u32 value = *ptr;
 
-				if (value >= start && value < end)
+				if (value % 4 || !verify_ref(_ptr.addr()))
 				{
-					if (is_valid_code({ ptr, ptr + (end - value) }, !is_relocatable, _ptr.addr()))
+					continue;
+				}
+
+				for (const auto& _seg : segs)
+				{
+					if (!_seg.size) continue;
+
+					if (value >= start && value < end)
 					{
-						continue;
-					}
+						if (is_valid_code({ ptr, ptr + (end - value) }, !is_relocatable, _ptr.addr()))
+						{
+							continue;
+						}
 
-					addr_heap.emplace(value, _ptr.addr());
-					break;
+						range.refs.emplace_back(value, _ptr.addr());
+						break;
+					}
 				}
 			}
 		}
+	};
+
+	// Small modules (most PRX) aren't worth the threads, they are also analysed concurrently by ppu_precompile
+	const u32 ref_threads = ref_ranges.size() >= 8 ? std::min<u32>(utils::get_thread_count(), ::size32(ref_ranges) / 4) : 1;
+
+	named_thread_group ref_workers("PPU Analyser "sv, ref_threads - 1, [&]()
+	{
+		find_refs();
+	});
+
+	find_refs();
+	ref_workers.join();
+
+	for (const ref_range& range : ref_ranges)
+	{
+		for (const auto& [value, addr] : range.refs)
+		{
+			addr_heap.emplace(value, addr);
+		}
 	}
 
 	// Find OPD section
@@ -1818,7 +2082,7 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 			return umax;
 		};
 
-		std::map<u32, u32> preserve_blocks;
+		decltype(func.blocks) preserve_blocks;
 
 		if (is_function_caller_analysis)
 		{
@@ -3274,5 +3538,11 @@ bool ppu_module<lv2_obj>::analyse(u32 lib_toc, u32 entry, const u32 sec_end, con
 	}
 
 	ppu_log.notice("Block analysis: %zu blocks (%zu enqueued)", funcs.size(), block_queue.size());
+
+	if (!cache_path.empty())
+	{
+		ppu_save_analysis_cache(cache_path, std::span(funcs).subspan(funcs_begin), stub_addr_to_constant_state_of_registers);
+	}
+
 	return true;
 }
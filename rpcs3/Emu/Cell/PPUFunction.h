@@ -4,11 +4,14 @@
 #include "PPUInterpreter.h"
 
 #include "util/v128.hpp"
+#include "util/tsc.hpp"
 
 // BIND_FUNC macro "converts" any appropriate HLE function to ppu_intrp_func_t, binding it to PPU thread context.
 #define BIND_FUNC(func, ...) (static_cast<ppu_intrp_func_t>([](ppu_thread& ppu, ppu_opcode_t, be_t<u32>* this_op, ppu_intrp_func*) {\
 	const auto old_f = ppu.current_function;\
 	if (!old_f) ppu.last_function = #func;\
+	const u64 hle_start = !old_f && !ppu.syscall_start ? utils::get_tsc() : 0;\
+	const u64 hle_suspended = ppu.suspended_time;\
 	ppu.current_function = #func;\
 	ppu.cia = vm::get_addr(this_op); \
 	std::memcpy(ppu.syscall_args, ppu.gpr + 3, sizeof(ppu.syscall_args)); \
@@ -20,6 +23,7 @@
 	history.error = ppu.gpr[3];\
 	if (ppu.syscall_history.count_debug_arguments) std::copy_n(ppu.syscall_args, std::size(history.args), history.args.data());\
 	ppu.current_function = old_f;\
+	if (hle_start) { const u64 hle_elapsed = utils::get_tsc() - hle_start; ppu.hle_time += hle_elapsed - std::min(hle_elapsed, ppu.suspended_time - hle_suspended); }\
 	ppu.cia += 4;\
 	__VA_ARGS__;\
 }))
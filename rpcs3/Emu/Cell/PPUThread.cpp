@@ -122,6 +122,31 @@ void fmt_class_string<ppu_thread_status>::format(std::string& out, u64 arg)
 	});
 }
 
+template <>
+void fmt_class_string<ppu_wait_type>::format(std::string& out, u64 arg)
+{
+	format_enum(out, arg, [](ppu_wait_type type)
+	{
+		switch (type)
+		{
+		case ppu_wait_type::mutex: return "mutex";
+		case ppu_wait_type::lwmutex: return "lwmutex";
+		case ppu_wait_type::cond: return "cond";
+		case ppu_wait_type::lwcond: return "lwcond";
+		case ppu_wait_type::rwlock: return "rwlock";
+		case ppu_wait_type::semaphore: return "semaphore";
+		case ppu_wait_type::event_queue: return "event queue";
+		case ppu_wait_type::event_flag: return "event flag";
+		case ppu_wait_type::sleep: return "sleep";
+		case ppu_wait_type::join: return "join";
+		case ppu_wait_type::other: return "other syscall";
+		case ppu_wait_type::__count: break;
+		}
+
+		return unknown;
+	});
+}
+
 template <>
 void fmt_class_string<typename ppu_thread::call_history_t>::format(std::string& out, u64 arg)
 {
@@ -2081,6 +2106,19 @@ void ppu_thread::dump_misc(std::string& ret, std::any& custom_data) const
 		}
 	}
 
+	if (const u64 tsc = utils::get_tsc(), start = start_tsc; start && tsc > start)
+	{
+		const f64 elapsed = static_cast<f64>(tsc - start);
+
+		fmt::append(ret, "Busy: %.1f%% (HLE: %.1f%%), Suspended: %.1f%%\n", get_busy_time() * 100. / elapsed, hle_time * 100. / elapsed, suspended_time * 100. / elapsed);
+
+		for (usz i = 0; i < wait_time.size(); i++)
+		{
+			if (const u64 v = wait_time[i])
+				fmt::append(ret, " ** Wait (%s): %.1f%%\n", static_cast<ppu_wait_type>(i), v * 100. / elapsed);
+		}
+	}
+
 	if (const auto _time = start_time)
 	{
 		fmt::append(ret, "Waiting: %fs\n", (get_guest_system_time() - _time) / 1000000.);
@@ -2096,6 +2134,136 @@ void ppu_thread::dump_misc(std::string& ret, std::any& custom_data) const
 	}
 }
 
+u64 ppu_thread::get_busy_time() const
+{
+	const u64 start = start_tsc;
+
+	if (!start)
+	{
+		return 0;
+	}
+
+	const u64 tsc = utils::get_tsc();
+
+	u64 waits = suspended_time;
+
+	for (u64 v : wait_time)
+	{
+		waits += v;
+	}
+
+	if (const u64 syscall = syscall_start; syscall && tsc > syscall)
+	{
+		// Syscall in progress (suspension during it is already in suspended_time)
+		waits += (tsc - syscall) - std::min(tsc - syscall, suspended_time - syscall_suspended);
+	}
+
+	const u64 elapsed = tsc > start ? tsc - start : 0;
+
+	// Values are read without synchronization
+	return elapsed > waits ? elapsed - waits : 0;
+}
+
+// Periodically samples time accounting of all PPU threads, saves the final sample to the log directory as CSV
+class ppu_time_stats
+{
+	struct entry
+	{
+		std::string name;
+		u64 elapsed;
+		u64 busy;
+		u64 hle;
+		u64 suspended;
+		std::array<u64, static_cast<usz>(ppu_wait_type::__count)> waits;
+	};
+
+	// Threads which have already exited are kept in the table
+	std::map<u32, entry> m_stats;
+
+	void sample()
+	{
+		const u64 tsc = utils::get_tsc();
+
+		idm::select<named_thread<ppu_thread>>([&](u32 id, named_thread<ppu_thread>& ppu)
+		{
+			if (!ppu.start_tsc || tsc <= ppu.start_tsc)
+			{
+				return;
+			}
+
+			m_stats.insert_or_assign(id, entry{ppu.get_name(), tsc - ppu.start_tsc, ppu.get_busy_time(), ppu.hle_time, ppu.suspended_time, ppu.wait_time});
+		});
+	}
+
+public:
+	void operator()()
+	{
+		if (!g_cfg.core.ppu_time_stats)
+		{
+			return;
+		}
+
+		u64 sleep_until = get_system_time();
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			thread_ctrl::wait_until(&sleep_until, 1'000'000);
+
+			if (!Emu.IsPaused())
+			{
+				sample();
+			}
+		}
+	}
+
+	~ppu_time_stats()
+	{
+		if (m_stats.empty())
+		{
+			return;
+		}
+
+		const u64 freq = utils::get_tsc_freq();
+
+		std::string csv = "id,name,elapsed_ms,busy_%,hle_%,suspended_%";
+
+		for (usz i = 0; i < static_cast<usz>(ppu_wait_type::__count); i++)
+		{
+			fmt::append(csv, ",%s_%%", static_cast<ppu_wait_type>(i));
+		}
+
+		csv += '\n';
+
+		for (const auto& [id, e] : m_stats)
+		{
+			const f64 elapsed = static_cast<f64>(e.elapsed);
+
+			fmt::append(csv, "0x%x,\"%s\",%u,%.2f,%.2f,%.2f", id, e.name, freq ? e.elapsed * 1000 / freq : 0, e.busy * 100. / elapsed, e.hle * 100. / elapsed, e.suspended * 100. / elapsed);
+
+			for (u64 v : e.waits)
+			{
+				fmt::append(csv, ",%.2f", v * 100. / elapsed);
+			}
+
+			csv += '\n';
+		}
+
+		const std::string path = fs::get_log_dir() + "ppu_thread_times.csv";
+
+		fs::pending_file file(path);
+
+		if (!file.file || file.file.write(csv.data(), csv.size()) != csv.size() || !file.commit())
+		{
+			ppu_log.error("Failed to save PPU thread times: %s (%s)", path, fs::g_tls_error);
+			return;
+		}
+
+		ppu_log.notice("Saved PPU thread times of %u thread(s): %s", m_stats.size(), path);
+	}
+
+	static constexpr auto thread_name = "PPU Time Stats Thread"sv;
+};
+
 void ppu_thread::dump_all(std::string& ret) const
 {
 	cpu_thread::dump_all(ret);
@@ -2436,6 +2604,9 @@ ppu_thread::ppu_thread(const ppu_thread_params& param, std::string_view name, u3
 {
 	prio.raw().prio = _prio;
 
+	// Initialize dependencies
+	g_fxo->need<named_thread<ppu_time_stats>>();
+
 	memset(&hv_ctx, 0, sizeof(hv_ctx));
 
 	gpr[1] = stack_addr + stack_size - ppu_stack_start_offset;
@@ -3239,11 +3410,16 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 
 	if (old_data != data || rtime != (res & -128))
 	{
+		vm::reservation_contention(addr, vm::reservation_fail::lost);
+		vm::reservation_backoff(addr);
+
 		ppu.raddr = 0;
 		ppu.res_cached = 0;
 		return false;
 	}
 
+	vm::reservation_fail fail_reason = vm::reservation_fail::lost;
+
 	if ([&]()
 	{
 		if (ppu.use_full_rdata) [[unlikely]]
@@ -3262,6 +3438,7 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 			if (!_ok)
 			{
 				// Already locked or updated: give up
+				fail_reason = vm::reservation_fail::locked;
 				return false;
 			}
 
@@ -3292,6 +3469,7 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 					}
 
 					res -= 64;
+					fail_reason = vm::reservation_fail::data;
 					return false;
 				}();
 			}
@@ -3326,6 +3504,7 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 		if (!_ok)
 		{
 			ppu.last_faddr = 0;
+			fail_reason = vm::reservation_fail::locked;
 			return false;
 		}
 
@@ -3336,6 +3515,8 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 			return true;
 		}
 
+		fail_reason = vm::reservation_fail::data;
+
 		const u64 old_rtime = res.fetch_sub(lock_bits);
 
 		// TODO: disabled with this setting on, since it's dangerous to mix
@@ -3433,6 +3614,8 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 		return true;
 	}
 
+	vm::reservation_contention(addr, fail_reason);
+
 	const u32 notify = ppu.res_notify;
 
 	// Do not risk postponing too much (because this is probably an indefinite loop)
@@ -3450,6 +3633,8 @@ static bool ppu_store_reservation(ppu_thread& ppu, u32 addr, u64 reg_value)
 		ppu.res_notify_postpone_streak = 0;
 	}
 
+	vm::reservation_backoff(addr);
+
 	ppu.raddr = 0;
 	ppu.res_cached = 0;
 	return false;
@@ -3563,6 +3748,298 @@ namespace
 			return *this;
 		}
 	};
+
+	// Samples the CIA of running PPU threads to find out which code is executed the most
+	// LLVM code only updates CIA on calls to other functions, returns, indirect branches and syscalls,
+	// so a sample counts for the function entered last (see PPUTranslator::CallFunction)
+	// Results are saved in the cache directory of each module and used to order LLVM compilation on the next boot
+	struct ppu_hotness_recorder
+	{
+		static constexpr u32 file_magic = "PPUH"_u32;
+		static constexpr u32 file_version = 1;
+
+		struct module_entry
+		{
+			std::string key; // JIT module name
+			std::string path; // Hotness file
+			u32 reloc = 0;
+			std::vector<u32> addrs; // Function addresses (sorted)
+			std::vector<u32> ends; // Function end addresses
+			std::vector<u32> counts; // Samples per function, including decayed samples of previous runs
+			bool updated = false;
+		};
+
+		shared_mutex mutex;
+		std::vector<module_entry> modules;
+
+		// Load relative function address -> sample count
+		static std::unordered_map<u32, u32> load(const std::string& path)
+		{
+			std::unordered_map<u32, u32> result;
+
+			const fs::file file(path);
+
+			if (!file)
+			{
+				return result;
+			}
+
+			const std::vector<u32> data = file.to_vector<u32>();
+
+			if (data.size() < 3 || data[0] != file_magic || data[1] != file_version || (data.size() - 3) / 2 < data[2])
+			{
+				ppu_log.warning("Ignoring invalid PPU hotness file: %s", path);
+				return result;
+			}
+
+			for (u32 i = 0; i < data[2]; i++)
+			{
+				result.emplace(data[3 + i * 2], data[4 + i * 2]);
+			}
+
+			return result;
+		}
+
+		static void save(const module_entry& mod)
+		{
+			std::vector<u32> data{file_magic, file_version, 0};
+
+			for (usz i = 0; i < mod.addrs.size(); i++)
+			{
+				if (mod.counts[i])
+				{
+					data.insert(data.end(), {mod.addrs[i] - mod.reloc, mod.counts[i]});
+					data[2]++;
+				}
+			}
+
+			fs::pending_file file(mod.path);
+
+			if (!file.file || file.file.write(data.data(), data.size() * sizeof(u32)) != data.size() * sizeof(u32) || !file.commit())
+			{
+				ppu_log.error("Failed to save PPU hotness file: %s (%s)", mod.path, fs::g_tls_error);
+				return;
+			}
+
+			ppu_log.notice("Saved PPU hotness of %u function(s): %s", data[2], mod.path);
+		}
+
+		void add(const std::string& key, const std::string& path, const ppu_module<lv2_obj>& info, u32 reloc, const std::unordered_map<u32, u32>& history)
+		{
+			module_entry mod{key, path, reloc};
+
+			for (const auto& func : info.get_funcs(false))
+			{
+				if (!func.size)
+				{
+					continue;
+				}
+
+				const auto found = history.find(func.addr - reloc);
+
+				mod.addrs.emplace_back(func.addr);
+				mod.ends.emplace_back(func.addr + func.size);
+
+				// Decay the history so the order can follow changes in the game (or its patches)
+				mod.counts.emplace_back(found == history.end() ? 0 : found->second / 2);
+			}
+
+			std::lock_guard lock(mutex);
+
+			std::erase_if(modules, [&](const module_entry& old) { return old.key == key; });
+			modules.emplace_back(std::move(mod));
+		}
+
+		void remove(const std::string& key)
+		{
+			std::lock_guard lock(mutex);
+
+			for (auto it = modules.begin(); it != modules.end(); it++)
+			{
+				if (it->key == key)
+				{
+					if (it->updated)
+					{
+						save(*it);
+					}
+
+					modules.erase(it);
+					return;
+				}
+			}
+		}
+
+		void save_all()
+		{
+			std::lock_guard lock(mutex);
+
+			for (module_entry& mod : modules)
+			{
+				if (mod.updated)
+				{
+					save(mod);
+					mod.updated = false;
+				}
+			}
+		}
+
+		void operator()()
+		{
+			if (g_cfg.core.ppu_decoder != ppu_decoder_type::llvm || !g_cfg.core.ppu_llvm_hotness_order)
+			{
+				return;
+			}
+
+			std::vector<u32> samples;
+
+			while (thread_ctrl::state() != thread_state::aborting)
+			{
+				if (!Emu.IsRunning())
+				{
+					if (Emu.IsStopped())
+					{
+						// Save results as soon as the emulation begins to stop
+						save_all();
+					}
+
+					thread_ctrl::wait_for(10'000);
+					continue;
+				}
+
+				samples.clear();
+
+				idm::select<named_thread<ppu_thread>>([&](u32, named_thread<ppu_thread>& ppu)
+				{
+					if (cpu_flag::wait - +ppu.state)
+					{
+						samples.emplace_back(atomic_storage<u32>::load(ppu.cia));
+					}
+				});
+
+				if (!samples.empty())
+				{
+					std::lock_guard lock(mutex);
+
+					for (u32 addr : samples)
+					{
+						for (module_entry& mod : modules)
+						{
+							const auto it = std::upper_bound(mod.addrs.begin(), mod.addrs.end(), addr);
+
+							if (it == mod.addrs.begin())
+							{
+								continue;
+							}
+
+							const usz index = it - mod.addrs.begin() - 1;
+
+							if (addr < mod.ends[index])
+							{
+								mod.counts[index] = std::min<u32>(mod.counts[index], u32{umax} - 1) + 1;
+								mod.updated = true;
+								break;
+							}
+						}
+					}
+				}
+
+				// Low rate is enough to rank functions over a session and keeps the cost of idm::select low
+				thread_ctrl::wait_for(10'000);
+			}
+
+			save_all();
+		}
+
+		static constexpr auto thread_name = "PPU Hotness Recorder"sv;
+	};
+
+	using ppu_hotness_thread = named_thread<ppu_hotness_recorder>;
+
+	// Set on threads compiling modules for the tiered mode
+	thread_local bool s_ppu_tier_background = false;
+
+	// Modules executed on the interpreter while their LLVM code is compiled in the background (tiered mode)
+	// Until the symbol resolver fills the function table, ppu_recompiler_fallback interprets their code
+	struct ppu_tier_manager
+	{
+		struct job_t
+		{
+			std::string key; // JIT module name
+			std::unique_ptr<named_thread<std::function<void()>>> thread;
+		};
+
+		shared_mutex mutex;
+		std::vector<job_t> jobs;
+
+		// Promotion statistics (latency in microseconds)
+		atomic_t<u32> promoted = 0;
+		atomic_t<u64> total_latency = 0;
+		atomic_t<u64> max_latency = 0;
+
+		void start(const std::string& key, const ppu_module<lv2_obj>& info, u64 file_size)
+		{
+			const auto start_time = std::chrono::steady_clock::now();
+
+			std::lock_guard lock(mutex);
+
+			jobs.emplace_back(job_t{key, std::make_unique<named_thread<std::function<void()>>>(fmt::format("PPU Tier %s", info.name), [this, &info, file_size, start_time]()
+			{
+				s_ppu_tier_background = true;
+
+				ppu_initialize(info, false, file_size);
+
+				if (Emu.IsStopped())
+				{
+					return;
+				}
+
+				const u64 latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count();
+				const u32 count = ++promoted;
+				const u64 total = total_latency.add_fetch(latency);
+				max_latency.fetch_op([&](u64& v) { v = std::max(v, latency); });
+
+				ppu_log.success("LLVM: Promoted '%s' to LLVM after %.3fs on the interpreter (%u module(s) promoted, average %.3fs, max %.3fs)"
+					, info.name, latency / 1e6, count, total / 1e6 / count, max_latency / 1e6);
+			})});
+		}
+
+		// Wait for the compilation of a module (before unloading it)
+		void join(const std::string& key)
+		{
+			std::unique_ptr<named_thread<std::function<void()>>> thread;
+			{
+				std::lock_guard lock(mutex);
+
+				const auto found = std::find_if(jobs.begin(), jobs.end(), [&](const job_t& job) { return job.key == key; });
+
+				if (found == jobs.end())
+				{
+					return;
+				}
+
+				thread = std::move(found->thread);
+				jobs.erase(found);
+			}
+
+			// Join
+			thread.reset();
+		}
+
+		ppu_tier_manager& operator=(thread_state s) noexcept
+		{
+			if (s == thread_state::aborting || s == thread_state::finished)
+			{
+				std::lock_guard lock(mutex);
+
+				for (job_t& job : jobs)
+				{
+					*job.thread = s;
+				}
+			}
+
+			return *this;
+		}
+	};
 }
 #endif
 
@@ -3711,7 +4188,9 @@ extern void ppu_finalize(const ppu_module<lv2_obj>& info, bool force_mem_release
 	fmt::append(cache_path, "ppu-%s-%s/", fmt::base57(info.sha1), info.path.substr(info.path.find_last_of('/') + 1));
 
 #ifdef LLVM_AVAILABLE
+	g_fxo->get<ppu_tier_manager>().join(cache_path + "_" + std::to_string(std::bit_cast<usz>(info.segs[0].ptr)));
 	g_fxo->get<jit_module_manager>().remove(cache_path + "_" + std::to_string(std::bit_cast<usz>(info.segs[0].ptr)));
+	g_fxo->get<ppu_hotness_thread>().remove(cache_path + "_" + std::to_string(std::bit_cast<usz>(info.segs[0].ptr)));
 #endif
 }
 
@@ -4463,6 +4942,12 @@ extern void ppu_initialize()
 
 	progress_dialog.reset();
 
+	if (g_cfg.core.ppu_llvm_tiered)
+	{
+		// Don't block the boot, modules are compiled in the background once loaded
+		dir_queue.clear();
+	}
+
 	ppu_precompile(dir_queue, &module_list, false);
 
 	if (Emu.IsStopped())
@@ -4594,6 +5079,13 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 	}
 
 #ifdef LLVM_AVAILABLE
+	if (g_cfg.core.ppu_llvm_tiered && !check_only && !s_ppu_tier_background && vm::base(info.segs[0].addr) == info.segs[0].ptr && ppu_initialize(info, true))
+	{
+		// Start on the interpreter, the function table is promoted to LLVM code when the background compilation finishes
+		g_fxo->get<ppu_tier_manager>().start(cache_path + "_" + std::to_string(std::bit_cast<usz>(info.segs[0].ptr)), info, file_size);
+		return false;
+	}
+
 	std::optional<scoped_progress_dialog> progress_dialog;
 
 	if (!check_only)
@@ -4602,8 +5094,28 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		progress_dialog.emplace(get_localized_string(localized_string_id::PROGRESS_DIALOG_LOADING_PPU_MODULES));
 	}
 
+	// Optional store of decompressed objects shared between emulator instances
+	std::string shared_store = g_cfg.core.llvm_shared_store.to_string();
+
+	if (!shared_store.empty())
+	{
+		if (shared_store.back() != '/')
+		{
+			shared_store += '/';
+		}
+
+		shared_store += "ppu/";
+
+		if (!fs::create_path(shared_store))
+		{
+			ppu_log.error("Failed to create shared LLVM cache store: %s (%s)", shared_store, fs::g_tls_error);
+			shared_store.clear();
+		}
+	}
+
 	// Permanently loaded compiled PPU modules (name -> data)
-	jit_module& jit_mod = g_fxo->get<jit_module_manager>().get(cache_path + "_" + std::to_string(std::bit_cast<usz>(info.segs[0].ptr)));
+	const std::string jit_mod_name = cache_path + "_" + std::to_string(std::bit_cast<usz>(info.segs[0].ptr));
+	jit_module& jit_mod = g_fxo->get<jit_module_manager>().get(jit_mod_name);
 
 	// Compiler instance (deferred initialization)
 	std::vector<std::shared_ptr<jit_compiler>>& jits = jit_mod.pjit;
@@ -4634,6 +5146,19 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 
 	const cpu_thread* cpu = cpu_thread::get_current();
 
+	// Function hotness recorded by previous runs (relative address -> samples)
+	std::unordered_map<u32, u32> hotness;
+
+	if (g_cfg.core.ppu_llvm_hotness_order && !check_only)
+	{
+		hotness = ppu_hotness_recorder::load(cache_path + "hotness.dat");
+
+		if (is_being_used_in_emulation && !jit_mod.init)
+		{
+			g_fxo->get<ppu_hotness_thread>().add(jit_mod_name, cache_path + "hotness.dat", info, reloc, hotness);
+		}
+	}
+
 	for (auto& func : info.get_funcs())
 	{
 		if (func.size == 0)
@@ -5144,6 +5669,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 				accurate_vnan,
 				accurate_nj_mode,
 				contains_symbol_resolver,
+				call_cia_stores,
 
 				__bitset_enum_max
 			};
@@ -5175,6 +5701,8 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 				settings += ppu_settings::accurate_nj_mode, settings -= ppu_settings::fixup_nj_denormals, fmt::throw_exception("NJ Not implemented");
 			if (fpos >= info.get_funcs().size() || module_counter % c_moudles_per_jit == c_moudles_per_jit - 1)
 				settings += ppu_settings::contains_symbol_resolver; // Avoid invalidating all modules for this purpose
+			if (g_cfg.core.ppu_prof || g_cfg.core.ppu_llvm_hotness_order)
+				settings += ppu_settings::call_cia_stores; // See PPUTranslator::CallFunction
 
 			// Write version, hash, CPU, settings
 			fmt::append(obj_name, "v7-kusa-%s-%s-%s.obj", fmt::base57(output, 16), fmt::base57(settings), jit_compiler::cpu(g_cfg.core.llvm_cpu));
@@ -5193,7 +5721,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		}
 
 		// Check object file
-		if (jit_compiler::check(cache_path + obj_name))
+		if (jit_compiler::check(cache_path + obj_name, shared_store))
 		{
 			if (!is_being_used_in_emulation && !check_only)
 			{
@@ -5229,6 +5757,42 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 		g_progr_fknown_bits += file_size;
 	}
 
+	if (workload.size() > 1 && !hotness.empty())
+	{
+		// Compile the parts executed the most by previous runs first, keep the address order otherwise
+		std::vector<std::pair<u64, usz>> order;
+		order.reserve(workload.size());
+
+		for (usz i = 0; i < workload.size(); i++)
+		{
+			u64 samples = 0;
+
+			for (const auto& func : workload[i].second.get_funcs())
+			{
+				if (const auto found = hotness.find(func.addr - reloc); found != hotness.end())
+				{
+					samples += found->second;
+				}
+			}
+
+			order.emplace_back(samples, i);
+		}
+
+		std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+		decltype(workload) sorted;
+		sorted.reserve(workload.size());
+
+		for (const auto& [samples, i] : order)
+		{
+			sorted.emplace_back(std::move(workload[i]));
+		}
+
+		workload = std::move(sorted);
+
+		ppu_log.notice("LLVM: Ordered %u module part(s) by hotness, %u part(s) have samples", workload.size(), std::count_if(order.begin(), order.end(), [](const auto& p) { return p.first != 0; }));
+	}
+
 	// Create worker threads for compilation
 	if (!workload.empty())
 	{
@@ -5390,7 +5954,7 @@ bool ppu_initialize(const ppu_module<lv2_obj>& info, bool check_only, u64 file_s
 				break;
 			}
 
-			if (!failed_to_load && !jits[mod_index / c_moudles_per_jit]->add(cache_path + obj_name))
+			if (!failed_to_load && !jits[mod_index / c_moudles_per_jit]->add(cache_path + obj_name, shared_store))
 			{
 				ppu_log.error("LLVM: Failed to load module %s", obj_name);
 				failed_to_load = true;
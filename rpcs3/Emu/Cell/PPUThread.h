@@ -50,6 +50,24 @@ enum ppu_thread_status : u32
 	PPU_THREAD_STATUS_UNKNOWN,
 };
 
+// Type of primitive a syscall may block on, for time accounting
+enum class ppu_wait_type : u32
+{
+	mutex,
+	lwmutex,
+	cond,
+	lwcond,
+	rwlock,
+	semaphore,
+	event_queue,
+	event_flag,
+	sleep,
+	join,
+	other, // Any other syscall
+
+	__count
+};
+
 // Formatting helper
 enum class ppu_syscall_code : u64
 {
@@ -302,6 +320,15 @@ public:
 	const char* last_function{}; // Sticky copy of current_function, is not cleared on function return
 	const char* current_module{}; // Current module name, for savestates.
 
+	// Time accounting in TSC ticks (see cpu_thread::start_tsc)
+	std::array<u64, static_cast<usz>(ppu_wait_type::__count)> wait_time{}; // Inside syscalls by blocking primitive
+	u64 syscall_start = 0; // Start of the current syscall, 0 outside of syscalls
+	u64 syscall_suspended = 0; // suspended_time at the start of the current syscall
+	u64 hle_time = 0; // Inside HLE functions (syscalls and suspension excluded)
+
+	// Get time spent running guest code or HLE functions (waits and suspension excluded)
+	u64 get_busy_time() const;
+
 	const bool is_interrupt_thread; // True for interrupts-handler threads
 
 	// Thread name
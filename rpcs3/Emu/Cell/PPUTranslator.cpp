@@ -594,7 +594,8 @@ void PPUTranslator::CallFunction(u64 target, Value* indirect)
 				callee = m_module->getOrInsertFunction(fmt::format("__0x%x", target_last - base), type);
 				cast<Function>(callee.getCallee())->setCallingConv(CallingConv::GHC);
 
-				if (g_cfg.core.ppu_prof)
+				// Publish the callee for samplers (indirect branches and returns already store CIA)
+				if (g_cfg.core.ppu_prof || g_cfg.core.ppu_llvm_hotness_order)
 				{
 					m_ir->CreateStore(GetAddr(target_last - m_addr), m_ir->CreateStructGEP(m_thread_type, m_thread, static_cast<uint>(&m_cia - m_locals)));
 				}
@@ -12,15 +12,18 @@
 #include "Utilities/StrUtil.h"
 #include "Utilities/JIT.h"
 #include "util/init_mutex.hpp"
+#include "util/fnv_hash.hpp"
 #include "util/shared_ptr.hpp"
 
 #include "Emu/Cell/Modules/cellSync.h"
+#include "Emu/Cell/timers.hpp"
 
 #include "SPUThread.h"
 #include "SPUAnalyser.h"
 #include "SPUInterpreter.h"
 #include "SPUDisAsm.h"
 #include <algorithm>
+#include <charconv>
 #include <cstring>
 #include <optional>
 #include <unordered_set>
@@ -550,6 +553,10 @@ DECLARE(spu_runtime::g_interpreter) = nullptr;
 spu_cache::spu_cache(const std::string& loc)
 	: m_file(loc, fs::read + fs::write + fs::create + fs::append)
 {
+	if (!g_cfg.core.llvm_shared_store.to_string().empty())
+	{
+		m_lock_path = loc + ".lock";
+	}
 }
 
 spu_cache::~spu_cache()
@@ -726,8 +733,94 @@ void spu_cache::add(const spu_program& func)
 		{func.data.data(), func.data.size() * 4}
 	};
 
-	// Append data
-	m_file.write_gather(gather, 3);
+	if (m_lock_path.empty())
+	{
+		// Append data
+		m_file.write_gather(gather, 3);
+		return;
+	}
+
+	// Other instances may append to the same file, keep entries whole
+	for (u32 i = 0; i < 100; i++)
+	{
+		if (fs::file lock{m_lock_path, fs::write + fs::create + fs::lock})
+		{
+			m_file.write_gather(gather, 3);
+			return;
+		}
+
+		thread_ctrl::wait_for(500);
+	}
+
+	spu_log.warning("SPU Cache: Failed to lock '%s', entry skipped (0x%05x)", m_lock_path, func.entry_point);
+}
+
+spu_cache::profile_t spu_cache::load_profile(const std::string& cache_path)
+{
+	profile_t result;
+
+	const fs::file file{cache_path + "spu_profile.csv"};
+
+	if (!file)
+	{
+		return result;
+	}
+
+	for (const std::string& line : fmt::split(file.to_string(), {"\n"}))
+	{
+		const std::vector<std::string> values = fmt::split(line, {","});
+
+		if (values.size() != 3)
+		{
+			continue;
+		}
+
+		u64 hash = 0, samples = 0, time = 0;
+
+		if (std::from_chars(values[0].data(), values[0].data() + values[0].size(), hash, 16).ec != std::errc{} ||
+			std::from_chars(values[1].data(), values[1].data() + values[1].size(), samples).ec != std::errc{} ||
+			std::from_chars(values[2].data(), values[2].data() + values[2].size(), time).ec != std::errc{})
+		{
+			// Header or broken line
+			continue;
+		}
+
+		auto& [old_samples, old_time] = result[hash];
+		old_samples += samples;
+		old_time += time;
+	}
+
+	return result;
+}
+
+void spu_cache::save_profile(const std::string& cache_path, const profile_t& profile)
+{
+	profile_t merged = load_profile(cache_path);
+
+	for (const auto& [hash, data] : profile)
+	{
+		auto& [samples, time] = merged[hash];
+		samples += data.first;
+		time += data.second;
+	}
+
+	// Sort by samples for readability
+	std::vector<std::pair<u64, std::pair<u64, u64>>> sorted(merged.begin(), merged.end());
+	std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.second.first > b.second.first; });
+
+	std::string out = "program,samples,time_us\n";
+
+	for (const auto& [hash, data] : sorted)
+	{
+		fmt::append(out, "%016x,%u,%u\n", hash, data.first, data.second);
+	}
+
+	fs::pending_file file(cache_path + "spu_profile.csv");
+
+	if (!file.file || file.file.write(out) != out.size() || !file.commit())
+	{
+		spu_log.error("Failed to save SPU profile to '%s' (%s)", cache_path, fs::g_tls_error);
+	}
 }
 
 void spu_cache::initialize(bool build_existing_cache)
@@ -772,6 +865,49 @@ void spu_cache::initialize(bool build_existing_cache)
 
 	// Read cache
 	auto func_list = cache.get();
+
+	// Compile the programs which were executing the most in previous runs first (see SPU Profiler)
+	if (const profile_t profile = load_profile(ppu_cache); !profile.empty() && func_list.size() > 1)
+	{
+		std::vector<std::pair<u64, usz>> order;
+		order.reserve(func_list.size());
+
+		usz hot_count = 0;
+
+		for (usz i = 0; i < func_list.size(); i++)
+		{
+			const spu_program& func = func_list[i];
+
+			be_t<u64> hash_start;
+			{
+				sha1_context ctx;
+				u8 output[20];
+
+				sha1_starts(&ctx);
+				sha1_update(&ctx, reinterpret_cast<const u8*>(func.data.data()), func.data.size() * 4);
+				sha1_finish(&ctx, output);
+				std::memcpy(&hash_start, output, sizeof(hash_start));
+			}
+
+			const auto found = profile.find(static_cast<u64>(hash_start) & ~0xffffull);
+			const u64 samples = found != profile.end() ? found->second.first : 0;
+			hot_count += samples != 0;
+			order.emplace_back(samples, i);
+		}
+
+		std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+		std::deque<spu_program> sorted;
+
+		for (const auto& [samples, index] : order)
+		{
+			sorted.emplace_back(std::move(func_list[index]));
+		}
+
+		func_list = std::move(sorted);
+
+		spu_log.notice("SPU Cache: %u of %u function(s) have profile samples and are compiled first", hot_count, func_list.size());
+	}
 	atomic_t<usz> fnext{};
 	atomic_t<u8> fail_flag{0};
 
@@ -1298,12 +1434,29 @@ spu_item* spu_runtime::add_empty(spu_program&& data)
 
 	if (ret)
 	{
+		const spu_program& func = ret->data;
+		const u32 offs = (func.entry_point - func.lower_bound) / 4;
+
+		::at32(m_index, get_index_hash(func.data.data() + offs, std::min<u32>(s_index_window, ::size32(func.data) - offs))).push(ret);
 		return ret;
 	}
 
 	return prev;
 }
 
+u32 spu_runtime::get_index_hash(const u32* code, u32 count)
+{
+	usz hash = rpcs3::fnv_seed;
+
+	for (u32 i = 0; i < count; i++)
+	{
+		hash = rpcs3::hash64(hash, code[i]);
+	}
+
+	hash = rpcs3::hash64(hash, count);
+	return static_cast<u32>(hash ^ (hash >> 32)) % (1u << 16);
+}
+
 spu_function_t spu_runtime::rebuild_ubertrampoline(u32 id_inst)
 {
 	// Prepare sorted list
@@ -1891,22 +2044,25 @@ spu_function_t spu_runtime::rebuild_ubertrampoline(u32 id_inst)
 
 spu_function_t spu_runtime::find(const u32* ls, u32 addr) const
 {
-	const u32 index = ls[addr / 4] >> 12;
-	for (const auto& item : ::at32(m_stuff, index))
+	// Functions are indexed by their first s_index_window instructions, or all of them if they are shorter
+	for (u32 count = std::min<u32>(s_index_window, 0x10000 - addr / 4); count; count--)
 	{
-		if (const auto ptr = item.compiled.load())
+		for (const spu_item* item : ::at32(m_index, get_index_hash(ls + addr / 4, count)))
 		{
-			std::span<const u32> range{item.data.data.data(), item.data.data.size()};
-			range = range.subspan((item.data.entry_point - item.data.lower_bound) / 4);
-
-			if (addr / 4 + range.size() > 0x10000)
+			if (const auto ptr = item->compiled.load())
 			{
-				continue;
-			}
+				std::span<const u32> range{item->data.data.data(), item->data.data.size()};
+				range = range.subspan((item->data.entry_point - item->data.lower_bound) / 4);
 
-			if (std::equal(range.begin(), range.end(), ls + addr / 4))
-			{
-				return ptr;
+				if (addr / 4 + range.size() > 0x10000)
+				{
+					continue;
+				}
+
+				if (std::equal(range.begin(), range.end(), ls + addr / 4))
+				{
+					return ptr;
+				}
 			}
 		}
 	}
@@ -8826,9 +8982,51 @@ void spu_recompiler_base::dump(const spu_program& result, std::string& out, u32
 	out += '\n';
 }
 
+// Statistics of the background upgrade from fast code to LLVM code
+struct spu_llvm_stats
+{
+	atomic_t<u32> queue_depth = 0; // Blocks waiting for LLVM compilation
+	atomic_t<u32> queue_peak = 0;
+	atomic_t<u64> upgraded = 0;
+	atomic_t<u64> total_latency = 0; // Time from submission to compiled (in microseconds)
+	atomic_t<u64> max_latency = 0;
+
+	void on_queued()
+	{
+		const u32 depth = ++queue_depth;
+		queue_peak.fetch_op([&](u32& v) { v = std::max(v, depth); });
+	}
+
+	void on_compiled(const spu_item& item)
+	{
+		queue_depth--;
+
+		const u64 latency = get_system_time() - item.queued_at;
+		const u64 count = ++upgraded;
+		total_latency += latency;
+		max_latency.fetch_op([&](u64& v) { v = std::max(v, latency); });
+
+		spu_log.trace("[0x%05x] Upgraded to LLVM in %.3fms (queue depth: %u)", item.data.entry_point, latency / 1000., +queue_depth);
+
+		if (count % 1000 == 0)
+		{
+			print();
+		}
+	}
+
+	void print() const
+	{
+		if (const u64 count = upgraded)
+		{
+			spu_log.notice("LLVM: %u block(s) upgraded, time to compiled: average %.3fms, max %.3fms (queue depth: %u, peak: %u)"
+				, count, total_latency / 1000. / count, max_latency / 1000., +queue_depth, +queue_peak);
+		}
+	}
+};
+
 struct spu_llvm_worker
 {
-	lf_queue<std::pair<u64, const spu_program*>> registered;
+	lf_queue<std::pair<u64, spu_item*>> registered;
 
 	void operator()()
 	{
@@ -8894,7 +9092,7 @@ struct spu_llvm_worker
 				set_relax_flag = true;
 			}
 
-			const auto& func = *prog->second;
+			const auto& func = prog->second->data;
 
 			// Get data start
 			const u32 start = func.lower_bound;
@@ -8912,6 +9110,7 @@ struct spu_llvm_worker
 			if (func2 != func)
 			{
 				spu_log.error("[0x%05x] SPU Analyser failed, %u vs %u", func2.entry_point, func2.data.size(), size0);
+				g_fxo->get<spu_llvm_stats>().queue_depth--;
 			}
 			else if (const auto target = compiler->compile(std::move(func2)))
 			{
@@ -8931,6 +9130,8 @@ struct spu_llvm_worker
 				bytes[7] = 0x90;
 
 				atomic_storage<u64>::release(*reinterpret_cast<u64*>(prog->first), result);
+
+				g_fxo->get<spu_llvm_stats>().on_compiled(*prog->second);
 			}
 			else
 			{
@@ -9052,6 +9253,7 @@ struct spu_llvm
 			for (const auto& pair : registered.pop_all())
 			{
 				enqueued.emplace(pair);
+				g_fxo->get<spu_llvm_stats>().on_queued();
 
 				// Interrupt and kick profiler thread
 				const auto lock = prof_mutex.init_always([&]{});
@@ -9099,10 +9301,10 @@ struct spu_llvm
 			}
 
 			// Start compiling
-			const spu_program& func = found_it->second->data;
+			spu_item* const item = found_it->second;
 
 			// Old function pointer (pre-recompiled)
-			const spu_function_t _old = found_it->second->compiled;
+			const spu_function_t _old = item->compiled;
 
 			// Remove item from the queue
 			enqueued.erase(found_it);
@@ -9114,7 +9316,7 @@ struct spu_llvm
 			}
 
 			// Push the workload
-			const bool notify = (workers.begin() + (worker_index % worker_count))->registered.template push<false>(reinterpret_cast<u64>(_old), &func);
+			const bool notify = (workers.begin() + (worker_index % worker_count))->registered.template push<false>(reinterpret_cast<u64>(_old), item);
 
 			if (notify && !notify_compile[worker_index % worker_count])
 			{
@@ -9147,6 +9349,8 @@ struct spu_llvm
 
 		static_cast<void>(prof_mutex.init_always([&]{ samples.clear(); }));
 
+		g_fxo->get<spu_llvm_stats>().print();
+
 		m_workers.reset();
 
 		for (u32 i = 0; i < worker_count; i++)
@@ -9519,6 +9723,7 @@ struct spu_fast : public spu_recompiler_base
 		else if (added)
 		{
 			// Send work to LLVM compiler thread
+			add_loc->queued_at = get_system_time();
 			g_fxo->get<spu_llvm_thread>().registered.push(m_hash_start, add_loc);
 		}
 
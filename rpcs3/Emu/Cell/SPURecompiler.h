@@ -10,6 +10,7 @@
 #include <memory>
 #include <string>
 #include <deque>
+#include <unordered_map>
 
 // std::bitset
 template <typename CT, typename T>
@@ -27,6 +28,9 @@ class spu_cache
 {
 	fs::file m_file;
 
+	// Lock file serializing appends from multiple emulator instances (shared cache store mode)
+	std::string m_lock_path;
+
 public:
 	spu_cache() = default;
 
@@ -49,6 +53,14 @@ public:
 
 	static void initialize(bool build_existing_cache = true);
 
+	// Execution profile of SPU programs collected by the CPU profiler (program hash -> {samples, time in microseconds})
+	using profile_t = std::unordered_map<u64, std::pair<u64, u64>>;
+
+	static profile_t load_profile(const std::string& cache_path);
+
+	// Merge new samples with the previous profile
+	static void save_profile(const std::string& cache_path, const profile_t& profile);
+
 	struct precompile_data_t
 	{
 		u32 vaddr;
@@ -92,6 +104,9 @@ public:
 	atomic_t<u8> cached = false;
 	atomic_t<u8> logged = false;
 
+	// Time of submission to the background LLVM compiler (for statistics)
+	u64 queued_at = 0;
+
 	spu_item(spu_program&& data)
 		: data(std::move(data))
 	{
@@ -108,6 +123,14 @@ class spu_runtime
 	// All functions (2^20 bunches)
 	std::array<lf_bunch<spu_item>, (1 << 20)> m_stuff;
 
+	// Index of all functions by the hash of their first instructions from the entry point (see find())
+	std::array<lf_bunch<spu_item*>, (1 << 16)> m_index;
+
+	// Number of instructions hashed for m_index (less for shorter functions)
+	static constexpr u32 s_index_window = 4;
+
+	static u32 get_index_hash(const u32* code, u32 count);
+
 	// Debug module output location
 	std::string m_cache_path;
 
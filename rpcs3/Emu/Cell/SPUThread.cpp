@@ -3117,9 +3117,21 @@ bool spu_thread::do_list_transfer(spu_mfc_cmd& args)
 			index = 0;
 		}
 
-		const u32 size = items[index].ts & ts_mask;
+		u32 size = items[index].ts & ts_mask;
 		const u32 addr = items[index].ea;
 
+		// Coalesce the following fetched elements if they are contiguous in both EA and LS (stall-and-notify ends the run)
+		// Inlined PUTs are limited in size so don't grow them beyond it
+		if (optimization_compatible)
+		{
+			const u32 max_size = optimization_compatible == MFC_PUT_CMD ? 0x400 : 0x4000;
+			const u32 merged = mfc_list_coalesce(items + index, std::min(fetch_size - index, (arg_size + 7) / 8), size, max_size, RAW_SPU_BASE_ADDR);
+
+			arg_size -= merged * 8;
+			item_ptr += merged;
+			index += merged;
+		}
+
 		// Try to inline the transfer
 		if (addr < RAW_SPU_BASE_ADDR && size && optimization_compatible == MFC_GET_CMD)
 		{
@@ -3334,6 +3346,8 @@ bool spu_thread::do_putllc(const spu_mfc_cmd& args)
 	// Store conditionally
 	const u32 addr = args.eal & -128;
 
+	vm::reservation_fail fail_reason = vm::reservation_fail::lost;
+
 	if ([&]()
 	{
 		perf_meter<"PUTLLC."_u64> perf2 = perf0;
@@ -3398,6 +3412,7 @@ bool spu_thread::do_putllc(const spu_mfc_cmd& args)
 		if (!_ok)
 		{
 			// Already locked or updated: give up
+			fail_reason = vm::reservation_fail::locked;
 			return false;
 		}
 
@@ -3443,6 +3458,12 @@ bool spu_thread::do_putllc(const spu_mfc_cmd& args)
 		}();
 
 		res += success ? 64 : 0 - 64;
+
+		if (!success)
+		{
+			fail_reason = vm::reservation_fail::data;
+		}
+
 		return success;
 	}())
 	{
@@ -3489,6 +3510,12 @@ bool spu_thread::do_putllc(const spu_mfc_cmd& args)
 			}
 		}
 
+		if (raddr == addr)
+		{
+			vm::reservation_contention(addr, fail_reason);
+			vm::reservation_backoff(addr);
+		}
+
 		if (!vm::check_addr(addr, vm::page_writable))
 		{
 			utils::trigger_write_page_fault(vm::base(addr));
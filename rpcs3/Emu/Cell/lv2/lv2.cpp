@@ -1239,6 +1239,40 @@ public:
 	static constexpr auto thread_name = "PPU Syscall Usage Thread"sv;
 };
 
+// Only syscalls which may block are charged to a wait type
+static ppu_wait_type ppu_syscall_wait_type(u64 code)
+{
+	switch (code)
+	{
+	case 44: // sys_ppu_thread_join
+	case 178: // sys_spu_thread_group_join
+		return ppu_wait_type::join;
+	case 85: // sys_event_flag_wait
+		return ppu_wait_type::event_flag;
+	case 92: // sys_semaphore_wait
+		return ppu_wait_type::semaphore;
+	case 97: // _sys_lwmutex_lock
+		return ppu_wait_type::lwmutex;
+	case 102: // sys_mutex_lock
+		return ppu_wait_type::mutex;
+	case 107: // sys_cond_wait
+		return ppu_wait_type::cond;
+	case 113: // _sys_lwcond_queue_wait
+		return ppu_wait_type::lwcond;
+	case 122: // sys_rwlock_rlock
+	case 125: // sys_rwlock_wlock
+		return ppu_wait_type::rwlock;
+	case 130: // sys_event_queue_receive
+		return ppu_wait_type::event_queue;
+	case 43: // sys_ppu_thread_yield
+	case 141: // sys_timer_usleep
+	case 142: // sys_timer_sleep
+		return ppu_wait_type::sleep;
+	default:
+		return ppu_wait_type::other;
+	}
+}
+
 extern void ppu_execute_syscall(ppu_thread& ppu, u64 code)
 {
 	if (g_cfg.core.ppu_decoder == ppu_decoder_type::llvm)
@@ -1255,7 +1289,15 @@ extern void ppu_execute_syscall(ppu_thread& ppu, u64 code)
 #ifdef __APPLE__
 			pthread_jit_write_protect_np(false);
 #endif
+			const u64 start = utils::get_tsc();
+			ppu.syscall_start = start;
+			ppu.syscall_suspended = ppu.suspended_time;
 			func(ppu, {}, vm::_ptr<u32>(ppu.cia), nullptr);
+
+			// Time paused by suspend_all during the syscall is only accounted as suspension
+			const u64 elapsed = utils::get_tsc() - start;
+			ppu.wait_time[static_cast<usz>(ppu_syscall_wait_type(code))] += elapsed - std::min(elapsed, ppu.suspended_time - ppu.syscall_suspended);
+			ppu.syscall_start = 0;
 			ppu_log.trace("Syscall '%s' (%llu) finished, r3=0x%llx", ppu_syscall_code(code), code, ppu.gpr[3]);
 
 #ifdef __APPLE__
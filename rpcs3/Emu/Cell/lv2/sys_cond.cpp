@@ -272,13 +272,13 @@ error_code sys_cond_signal_all(ppu_thread& ppu, u32 cond_id)
 				auto sq = cond.sq;
 				atomic_storage<ppu_thread*>::release(cond.sq, nullptr);
 
-				while (const auto cpu = cond.schedule<ppu_thread>(sq, SYS_SYNC_PRIORITY))
+				cond.schedule_all<ppu_thread>(sq, SYS_SYNC_PRIORITY, [&](ppu_thread* cpu)
 				{
 					if (cond.mutex->try_own(*cpu))
 					{
 						ensure(!std::exchange(result, cpu));
 					}
-				}
+				});
 
 				if (result)
 				{
@@ -512,14 +512,13 @@ error_code sys_event_flag_cancel(ppu_thread& ppu, u32 id, vm::ptr<u32> num)
 		const u64 pattern = flag->pattern;
 
 		// Signal all threads to return CELL_ECANCELED (protocol does not matter)
-		while (auto ppu = flag->schedule<ppu_thread>(flag->sq, SYS_SYNC_FIFO))
+		value = ::narrow<u32>(flag->schedule_all<ppu_thread>(flag->sq, SYS_SYNC_FIFO, [&](ppu_thread* ppu)
 		{
 			ppu->gpr[3] = CELL_ECANCELED;
 			ppu->gpr[6] = pattern;
 
-			value++;
 			flag->append(ppu);
-		}
+		}));
 
 		if (value)
 		{
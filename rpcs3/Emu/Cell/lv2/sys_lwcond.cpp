@@ -358,8 +358,6 @@ error_code _sys_lwcond_signal_all(ppu_thread& ppu, u32 lwcond_id, u32 lwmutex_id
 					return 0;
 				}
 
-				u32 result = 0;
-
 				for (auto cpu = +cond.sq; cpu; cpu = cpu->next_cpu)
 				{
 					if (cpu->state & cpu_flag::again)
@@ -372,11 +370,11 @@ error_code _sys_lwcond_signal_all(ppu_thread& ppu, u32 lwcond_id, u32 lwmutex_id
 				auto sq = cond.sq;
 				atomic_storage<ppu_thread*>::release(cond.sq, nullptr);
 
-				while (const auto cpu = cond.schedule<ppu_thread>(sq, cond.protocol))
+				const u32 result = ::narrow<u32>(cond.schedule_all<ppu_thread>(sq, cond.protocol, [&](ppu_thread* cpu)
 				{
 					if (mode == 2)
 					{
-						static_cast<ppu_thread*>(cpu)->gpr[3] = CELL_EBUSY;
+						cpu->gpr[3] = CELL_EBUSY;
 					}
 
 					if (mode == 1)
@@ -387,9 +385,7 @@ error_code _sys_lwcond_signal_all(ppu_thread& ppu, u32 lwcond_id, u32 lwmutex_id
 					{
 						lv2_obj::append(cpu);
 					}
-
-					result++;
-				}
+				}));
 
 				if (result && mode == 2)
 				{
@@ -78,6 +78,8 @@ void lv2_socket::poll_queue(shared_ptr<ppu_thread> ppu, bs_t<lv2_socket::poll_t>
 		{
 			nc.num_polls.notify_one();
 		}
+
+		nc.update_socket(lv2_id);
 	}
 }
 
@@ -107,8 +109,10 @@ u32 lv2_socket::clear_queue(ppu_thread* ppu)
 	if (cleared && (type == SYS_NET_SOCK_STREAM || type == SYS_NET_SOCK_DGRAM))
 	{
 		// Makes sure network_context thread can go back to sleep if there is no active polling
-		const u32 prev_value = g_fxo->get<network_context>().num_polls.fetch_sub(cleared);
+		auto& nc = g_fxo->get<network_context>();
+		const u32 prev_value = nc.num_polls.fetch_sub(cleared);
 		ensure(prev_value >= cleared);
+		nc.update_socket(lv2_id);
 	}
 
 	return cleared;
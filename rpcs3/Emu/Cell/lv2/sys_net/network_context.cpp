@@ -6,6 +6,14 @@
 #include "network_context.h"
 #include "sys_net_helpers.h"
 
+#ifdef __linux__
+#include <unordered_map>
+#include <unordered_set>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
 LOG_CHANNEL(sys_net);
 
 // Used by RPCN to send signaling packets to RPCN server(for UDP hole punching)
@@ -163,9 +171,87 @@ void base_network_thread::wake_threads()
 	}
 }
 
+#ifdef __linux__
+// Token for the wakeup eventfd in epoll_event::data
+static constexpr u64 s_epoll_wakeup = umax;
+
+static bool create_epoll(int& epoll_fd, int& wakeup_fd)
+{
+	epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+	wakeup_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+	::epoll_event ev{};
+	ev.events = EPOLLIN;
+	ev.data.u64 = s_epoll_wakeup;
+
+	if (epoll_fd < 0 || wakeup_fd < 0 || ::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wakeup_fd, &ev) != 0)
+	{
+		sys_net.error("Failed to create epoll instance, falling back to polling: %s", get_last_error(false));
+
+		if (epoll_fd >= 0)
+			::close(epoll_fd);
+		if (wakeup_fd >= 0)
+			::close(wakeup_fd);
+
+		epoll_fd = -1;
+		wakeup_fd = -1;
+		return false;
+	}
+
+	return true;
+}
+
+static void destroy_epoll(int epoll_fd, int wakeup_fd)
+{
+	if (epoll_fd >= 0)
+		::close(epoll_fd);
+	if (wakeup_fd >= 0)
+		::close(wakeup_fd);
+}
+
+static void signal_epoll(int wakeup_fd)
+{
+	if (wakeup_fd >= 0)
+	{
+		const u64 value = 1;
+		[[maybe_unused]] const auto res = ::write(wakeup_fd, &value, sizeof(value));
+	}
+}
+
+network_thread::network_thread()
+{
+	create_epoll(epoll_fd, wakeup_fd);
+}
+
+network_thread::~network_thread()
+{
+	destroy_epoll(epoll_fd, wakeup_fd);
+}
+
+network_thread& network_thread::operator=(thread_state)
+{
+	signal_epoll(wakeup_fd);
+	return *this;
+}
+
+p2p_thread::~p2p_thread()
+{
+	destroy_epoll(epoll_fd, wakeup_fd);
+}
+
+p2p_thread& p2p_thread::operator=(thread_state)
+{
+	signal_epoll(wakeup_fd);
+	return *this;
+}
+#endif
+
 p2p_thread::p2p_thread()
 {
 	np::init_np_handler_dependencies();
+#ifdef __linux__
+	create_epoll(epoll_fd, wakeup_fd);
+#endif
 }
 
 void p2p_thread::bind_sce_np_port()
@@ -174,16 +260,200 @@ void p2p_thread::bind_sce_np_port()
 	create_p2p_port(SCE_NP_PORT);
 }
 
-void network_thread::operator()()
+void network_thread::update_socket([[maybe_unused]] u32 lv2_id)
 {
-	std::vector<shared_ptr<lv2_socket>> socklist;
-	socklist.reserve(lv2_socket::id_count);
+#ifdef __linux__
+	if (epoll_fd >= 0)
+	{
+		changed_sockets.push(lv2_id);
+		signal_epoll(wakeup_fd);
+	}
+#endif
+}
 
+void network_thread::operator()()
+{
 	{
 		std::lock_guard lock(mutex_ppu_to_awake);
 		ppu_to_awake.clear();
 	}
 
+#ifdef __linux__
+	if (epoll_fd >= 0)
+	{
+		epoll_loop();
+		return;
+	}
+#endif
+
+	poll_loop();
+}
+
+#ifdef __linux__
+void network_thread::epoll_loop()
+{
+	struct registered_socket
+	{
+		socket_type fd;
+		u32 mask;
+	};
+
+	// Sockets currently registered in epoll
+	std::unordered_map<u32, registered_socket> registered;
+
+	// Sockets with pending polls and a receive or send timeout, they need to be checked periodically
+	std::unordered_set<u32> timed;
+
+	// Sync the epoll registration of a socket with its current poll events
+	auto sync_socket = [&](u32 id)
+	{
+		const auto sock = idm::get_unlocked<lv2_socket>(id);
+
+		socket_type fd = -1;
+		u32 mask = 0;
+
+		if (sock && (sock->get_type() == SYS_NET_SOCK_DGRAM || sock->get_type() == SYS_NET_SOCK_STREAM))
+		{
+			const auto events = sock->get_events();
+
+			fd = sock->get_socket();
+			mask =
+				(events & lv2_socket::poll_t::read ? EPOLLIN : 0) |
+				(events & lv2_socket::poll_t::write ? EPOLLOUT : 0) |
+				0;
+		}
+
+		if (sock && sock->get_queue_size() && (sock->so_rcvtimeo || sock->so_sendtimeo))
+		{
+			timed.emplace(id);
+		}
+		else
+		{
+			timed.erase(id);
+		}
+
+		auto found = registered.find(id);
+
+		if (found != registered.end() && (found->second.fd != fd || !mask))
+		{
+			// The descriptor may have been closed (and reused by another socket) in the meantime
+			const socket_type old_fd = found->second.fd;
+			registered.erase(found);
+			found = registered.end();
+
+			if (std::none_of(registered.begin(), registered.end(), [&](const auto& r) { return r.second.fd == old_fd; }))
+			{
+				::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, old_fd, nullptr);
+			}
+		}
+
+		if (!mask || fd < 0)
+		{
+			return;
+		}
+
+		::epoll_event ev{};
+		ev.events = mask;
+		ev.data.u64 = id;
+
+		if (found == registered.end())
+		{
+			if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0 && (errno != EEXIST || ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev) != 0))
+			{
+				sys_net.error("Failed to register socket %d in epoll: %s", id, get_last_error(false));
+				return;
+			}
+
+			registered.emplace(id, registered_socket{fd, mask});
+		}
+		else if (found->second.mask != mask)
+		{
+			if (::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev) != 0)
+			{
+				sys_net.error("Failed to update socket %d in epoll: %s", id, get_last_error(false));
+			}
+
+			found->second.mask = mask;
+		}
+	};
+
+	std::array<::epoll_event, 64> ready{};
+
+	while (thread_ctrl::state() != thread_state::aborting)
+	{
+		for (u32 id : changed_sockets.pop_all())
+		{
+			sync_socket(id);
+		}
+
+		// Only wake up periodically if a socket is waiting with a timeout
+		const int count = ::epoll_wait(epoll_fd, ready.data(), ::size32(ready), timed.empty() ? -1 : 1);
+
+		if (count < 0 && errno != EINTR)
+		{
+			sys_net.error("epoll_wait failed: %s", get_last_error(false));
+		}
+
+		std::lock_guard lock(mutex_thread_loop);
+
+		for (int i = 0; i < count; i++)
+		{
+			if (ready[i].data.u64 == s_epoll_wakeup)
+			{
+				u64 value;
+				[[maybe_unused]] const auto res = ::read(wakeup_fd, &value, sizeof(value));
+				continue;
+			}
+
+			const u32 id = static_cast<u32>(ready[i].data.u64);
+
+			if (const auto sock = idm::get_unlocked<lv2_socket>(id))
+			{
+				const u32 revents = ready[i].events;
+
+				::pollfd native_pfd{};
+				native_pfd.fd = sock->get_socket();
+				native_pfd.revents = static_cast<short>(
+					(revents & EPOLLIN ? POLLIN : 0) |
+					(revents & EPOLLOUT ? POLLOUT : 0) |
+					(revents & EPOLLERR ? POLLERR : 0) |
+					(revents & EPOLLHUP ? POLLHUP : 0));
+
+				sock->handle_events(native_pfd);
+			}
+
+			// Level triggered: drop the interest if the events were consumed
+			sync_socket(id);
+		}
+
+		if (!timed.empty())
+		{
+			for (u32 id : std::vector<u32>(timed.begin(), timed.end()))
+			{
+				if (const auto sock = idm::get_unlocked<lv2_socket>(id))
+				{
+					sock->handle_events(::pollfd{});
+				}
+
+				sync_socket(id);
+			}
+		}
+
+		wake_threads();
+	}
+
+	for (const auto& [id, reg] : registered)
+	{
+		::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, reg.fd, nullptr);
+	}
+}
+#endif
+
+void network_thread::poll_loop()
+{
+	std::vector<shared_ptr<lv2_socket>> socklist;
+	socklist.reserve(lv2_socket::id_count);
+
 	std::vector<::pollfd> fds(lv2_socket::id_count);
 #ifdef _WIN32
 	std::vector<bool> connecting(lv2_socket::id_count);
@@ -254,7 +524,23 @@ void p2p_thread::create_p2p_port(u16 p2p_port)
 {
 	if (!list_p2p_ports.contains(p2p_port))
 	{
-		list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(p2p_port), std::forward_as_tuple(p2p_port));
+		const auto& [it, _] = list_p2p_ports.emplace(std::piecewise_construct, std::forward_as_tuple(p2p_port), std::forward_as_tuple(p2p_port));
+
+#ifdef __linux__
+		if (epoll_fd >= 0)
+		{
+			::epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.u64 = p2p_port;
+
+			if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, it->second.p2p_socket, &ev) != 0)
+			{
+				sys_net.error("[P2P] Failed to register port %d in epoll: %s", p2p_port, get_last_error(false));
+			}
+		}
+#else
+		static_cast<void>(it);
+#endif
 		const u32 prev_value = num_p2p_ports.fetch_add(1);
 		if (!prev_value)
 		{
@@ -265,6 +551,50 @@ void p2p_thread::create_p2p_port(u16 p2p_port)
 
 void p2p_thread::operator()()
 {
+#ifdef __linux__
+	if (epoll_fd >= 0)
+	{
+		std::array<::epoll_event, 16> ready{};
+
+		while (thread_ctrl::state() != thread_state::aborting)
+		{
+			const int count = ::epoll_wait(epoll_fd, ready.data(), ::size32(ready), -1);
+
+			if (count < 0)
+			{
+				if (errno != EINTR)
+				{
+					sys_net.error("[P2P] epoll_wait failed: %s", get_last_error(false));
+				}
+
+				continue;
+			}
+
+			std::lock_guard lock(list_p2p_ports_mutex);
+
+			for (int i = 0; i < count; i++)
+			{
+				if (ready[i].data.u64 == s_epoll_wakeup)
+				{
+					u64 value;
+					[[maybe_unused]] const auto res = ::read(wakeup_fd, &value, sizeof(value));
+					continue;
+				}
+
+				if (const auto found = list_p2p_ports.find(static_cast<u16>(ready[i].data.u64)); found != list_p2p_ports.end())
+				{
+					while (found->second.recv_data())
+						;
+				}
+			}
+
+			wake_threads();
+		}
+
+		return;
+	}
+#endif
+
 	std::vector<::pollfd> p2p_fd(lv2_socket::id_count);
 
 	while (thread_ctrl::state() != thread_state::aborting)
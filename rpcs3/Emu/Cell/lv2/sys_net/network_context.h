@@ -3,6 +3,7 @@
 #include <vector>
 #include <map>
 #include "Utilities/mutex.h"
+#include "Utilities/lockless.h"
 #include "Emu/Cell/PPUThread.h"
 
 #include "nt_p2p_port.h"
@@ -23,9 +24,31 @@ struct network_thread : base_network_thread
 	shared_mutex mutex_thread_loop;
 	atomic_t<u32> num_polls = 0;
 
+#ifdef __linux__
+	// Sockets with pending polls are registered in epoll, so the thread only wakes up when something happens
+	int epoll_fd = -1;
+	int wakeup_fd = -1;
+
+	// IDs of sockets whose poll events changed since the last iteration
+	lf_queue<u32> changed_sockets;
+
+	network_thread();
+	~network_thread();
+	network_thread& operator=(thread_state);
+#endif
+
 	static constexpr auto thread_name = "Network Thread";
 
+	// Notify the thread that the poll events of a socket changed
+	void update_socket(u32 lv2_id);
+
 	void operator()();
+
+private:
+	void poll_loop();
+#ifdef __linux__
+	void epoll_loop();
+#endif
 };
 
 struct p2p_thread : base_network_thread
@@ -34,9 +57,18 @@ struct p2p_thread : base_network_thread
 	std::map<u16, nt_p2p_port> list_p2p_ports;
 	atomic_t<u32> num_p2p_ports = 0;
 
+#ifdef __linux__
+	int epoll_fd = -1;
+	int wakeup_fd = -1;
+#endif
+
 	static constexpr auto thread_name = "Network P2P Thread";
 
 	p2p_thread();
+#ifdef __linux__
+	~p2p_thread();
+	p2p_thread& operator=(thread_state);
+#endif
 
 	void create_p2p_port(u16 p2p_port);
 
@@ -1374,6 +1374,7 @@ rsxaudio_backend_thread::emu_audio_cfg rsxaudio_backend_thread::get_emu_cfg()
 		.dump_to_file = static_cast<bool>(g_cfg.audio.dump_to_file),
 		.channels = out_ch_cnt,
 		.channel_layout = g_cfg.audio.channel_layout,
+		.resampler = g_cfg.audio.time_stretching_resampler,
 		.renderer = g_cfg.audio.renderer,
 		.provider = g_cfg.audio.provider,
 		.avport = convert_avport(g_cfg.audio.rsxaudio_port)
@@ -1499,7 +1500,7 @@ void rsxaudio_backend_thread::operator()()
 
 			if (emu_cfg.enable_time_stretching)
 			{
-				resampler.set_params(backend_current_cfg.cfg.ch_cnt, backend_current_cfg.cfg.freq);
+				resampler.set_params(backend_current_cfg.cfg.ch_cnt, backend_current_cfg.cfg.freq, emu_cfg.resampler);
 				resampler.set_tempo(RESAMPLER_MAX_FREQ_VAL);
 			}
 
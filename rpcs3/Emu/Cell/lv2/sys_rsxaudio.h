@@ -478,6 +478,7 @@ private:
 		bool dump_to_file = false;
 		AudioChannelCnt channels = AudioChannelCnt::STEREO;
 		audio_channel_layout channel_layout = audio_channel_layout::automatic;
+		audio_resampler_type resampler = audio_resampler_type::soundtouch;
 		audio_renderer renderer = audio_renderer::null;
 		audio_provider provider = audio_provider::none;
 		RsxaudioAvportIdx avport = RsxaudioAvportIdx::HDMI_0;
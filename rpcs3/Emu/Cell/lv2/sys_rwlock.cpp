@@ -453,14 +453,11 @@ error_code sys_rwlock_wlock(ppu_thread& ppu, u32 rw_lock_id, u64 timeout)
 				// If the last waiter quit the writer sleep queue, wake blocked readers
 				if (rwlock->rq && !rwlock->wq && rwlock->owner < 0)
 				{
-					s64 size = 0;
-
 					// Protocol doesn't matter here since they are all enqueued anyways
-					while (auto cpu = rwlock->schedule<ppu_thread>(rwlock->rq, SYS_SYNC_FIFO))
+					const s64 size = rwlock->schedule_all<ppu_thread>(rwlock->rq, SYS_SYNC_FIFO, [&](ppu_thread* cpu)
 					{
-						size++;
 						rwlock->append(cpu);
-					}
+					});
 
 					rwlock->owner.atomic_op([&](s64& owner)
 					{
@@ -571,14 +568,11 @@ error_code sys_rwlock_wunlock(ppu_thread& ppu, u32 rw_lock_id)
 				}
 			}
 
-			s64 size = 0;
-
 			// Protocol doesn't matter here since they are all enqueued anyways
-			while (auto cpu = rwlock->schedule<ppu_thread>(rwlock->rq, SYS_SYNC_FIFO))
+			const s64 size = rwlock->schedule_all<ppu_thread>(rwlock->rq, SYS_SYNC_FIFO, [&](ppu_thread* cpu)
 			{
-				size++;
 				rwlock->append(cpu);
-			}
+			});
 
 			rwlock->owner.release(-2 * static_cast<s64>(size));
 			lv2_obj::awake_all();
@@ -226,6 +226,64 @@ public:
 		return found;
 	}
 
+	// Remove all objects from the linked set and call func for each one in the order of the protocol
+	// Same result as calling schedule() until the set is empty, but scans the set only once (objects with cpu_flag::again are left in place)
+	template <typename E, typename T, typename F>
+	static usz schedule_all(T& first, u32 protocol, F&& func)
+	{
+		// Sort key: priority level first, then enqueue order (both signed, compared as in schedule())
+		using sort_key = std::pair<s64, s64>;
+
+		// Reuse the allocation (swapped out in case func reenters)
+		static thread_local std::vector<std::pair<sort_key, E*>> s_list;
+
+		std::vector<std::pair<sort_key, E*>> list = std::move(s_list);
+		list.clear();
+
+		auto parent = &first;
+
+		for (auto it = static_cast<E*>(first); it;)
+		{
+			const auto next = static_cast<E*>(+it->next_cpu);
+
+			if (cpu_flag::again - it->state)
+			{
+				atomic_storage<T>::release(*parent, next);
+				atomic_storage<T>::release(it->next_cpu, nullptr);
+
+				const auto prio = it->prio.load();
+
+				list.emplace_back(protocol == SYS_SYNC_FIFO ? sort_key{} : sort_key{prio.prio, prio.order}, it);
+			}
+			else
+			{
+				parent = &it->next_cpu;
+			}
+
+			it = next;
+		}
+
+		if (protocol == SYS_SYNC_FIFO)
+		{
+			// The set is in LIFO order
+			std::reverse(list.begin(), list.end());
+		}
+		else
+		{
+			// Stable: on equal keys, schedule() picks the object closest to the head first
+			std::stable_sort(list.begin(), list.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		}
+
+		for (const auto& [key, object] : list)
+		{
+			func(object);
+		}
+
+		const usz count = list.size();
+		s_list = std::move(list);
+		return count;
+	}
+
 	template <typename T>
 	static void emplace(T& first, T object)
 	{
@@ -4,6 +4,8 @@
 #include "IPC_socket.h"
 #include "rpcs3_version.h"
 
+extern atomic_t<u32> g_emu_flip_count;
+
 
 namespace IPC_socket
 {
@@ -47,6 +49,56 @@ namespace IPC_socket
 		vm::write64(addr, value);
 	}
 
+	bool IPC_impl::read_range(u32 addr, u32 size, char* out)
+	{
+		if (!size || !vm::check_addr(addr, vm::page_readable, size))
+		{
+			return false;
+		}
+
+		std::memcpy(out, vm::base(addr), size);
+		return true;
+	}
+
+	bool IPC_impl::write_range(u32 addr, u32 size, const char* data)
+	{
+		if (!size || !vm::check_addr(addr, vm::page_writable, size))
+		{
+			return false;
+		}
+
+		std::memcpy(vm::base(addr), data, size);
+		return true;
+	}
+
+	u32 IPC_impl::wait_flip(u32 last_flip, u32 timeout_ms)
+	{
+		// Limit the wait so the server stays responsive to shutdown
+		const u64 timeout_ns = std::min<u64>(timeout_ms, 1000) * 1'000'000;
+
+		if (g_emu_flip_count == last_flip && timeout_ns)
+		{
+			g_emu_flip_count.wait(last_flip, atomic_wait_timeout{timeout_ns});
+		}
+
+		return g_emu_flip_count;
+	}
+
+	std::string IPC_impl::get_shared_memory(u32& addr, u32& size)
+	{
+		// Only main memory is exposed, the client is expected to map it read-only
+		const auto block = vm::get(vm::main);
+
+		if (!block)
+		{
+			return {};
+		}
+
+		addr = block->addr;
+		size = block->size;
+		return block->get_shared_path();
+	}
+
 	int IPC_impl::get_port()
 	{
 		return g_cfg_ipc.get_port();
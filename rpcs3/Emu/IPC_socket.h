@@ -26,6 +26,10 @@ namespace IPC_socket
 		static void write32(u32 addr, be_t<u32> value);
 		static const be_t<u64>& read64(u32 addr);
 		static void write64(u32 addr, be_t<u64> value);
+		static bool read_range(u32 addr, u32 size, char* out);
+		static bool write_range(u32 addr, u32 size, const char* data);
+		static u32 wait_flip(u32 last_flip, u32 timeout_ms);
+		static std::string get_shared_memory(u32& addr, u32& size);
 
 		template<typename... Args>
 		static void error(const const_str& fmt, Args&&... args)
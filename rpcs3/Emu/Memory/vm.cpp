@@ -10,6 +10,7 @@
 #include "Emu/RSX/RSXThread.h"
 #include "Emu/Cell/SPURecompiler.h"
 #include "Emu/perf_meter.hpp"
+#include "Emu/Cell/timers.hpp"
 #include <deque>
 #include <span>
 
@@ -635,8 +636,130 @@ namespace vm
 		return nullptr;
 	}
 
+	struct alignas(64) reservation_line_stats
+	{
+		atomic_t<u32> addr; // Line address + 1, 0 if unused
+		atomic_t<u32> window; // Time in ms of the last update
+		atomic_t<u32> score; // Recent failures, halved for each elapsed window
+		std::array<atomic_t<u32>, static_cast<u32>(reservation_fail::__count)> fails;
+	};
+
+	static std::array<reservation_line_stats, 4096> s_rsrv_stats{};
+
+	static reservation_line_stats& reservation_stats(u32 addr)
+	{
+		return s_rsrv_stats[((addr / 128) * 0x9e3779b1u) >> 20];
+	}
+
+	void reservation_contention(u32 addr, reservation_fail reason)
+	{
+		if (!g_cfg.core.reservation_contention_stats && !g_cfg.core.reservation_adaptive_backoff)
+		{
+			return;
+		}
+
+		auto& stats = reservation_stats(addr);
+		const u32 tag = (addr & -128) + 1;
+		const u32 now = static_cast<u32>(get_system_time() / 1000);
+
+		if (const u32 old = stats.addr; old != tag)
+		{
+			// Only take over the slot if the other line has not been contended lately
+			if ((old && now - stats.window < 1000) || !stats.addr.compare_and_swap_test(old, tag))
+			{
+				return;
+			}
+
+			stats.score.release(0);
+
+			for (auto& count : stats.fails)
+			{
+				count.release(0);
+			}
+		}
+
+		if (const u32 window = stats.window; window != now && stats.window.compare_and_swap_test(window, now))
+		{
+			const u32 shift = std::min<u32>(now - window, 31);
+			stats.score.atomic_op([&](u32& v) { v >>= shift; });
+		}
+
+		stats.score++;
+		stats.fails[static_cast<u32>(reason)]++;
+	}
+
+	void reservation_backoff(u32 addr)
+	{
+		if (!g_cfg.core.reservation_adaptive_backoff)
+		{
+			return;
+		}
+
+		const auto& stats = reservation_stats(addr);
+
+		if (stats.addr != (addr & -128) + 1)
+		{
+			return;
+		}
+
+		// Light contention is not delayed, then grow with the amount of failures in the last milliseconds
+		if (const u32 score = stats.score; score > 8)
+		{
+			busy_wait(std::min<u32>(100 + (score - 8) * 32, 4000));
+		}
+	}
+
+	void reservation_contention_report()
+	{
+		if (!g_cfg.core.reservation_contention_stats)
+		{
+			return;
+		}
+
+		std::vector<std::pair<u64, const reservation_line_stats*>> lines;
+
+		for (const auto& stats : s_rsrv_stats)
+		{
+			if (stats.addr)
+			{
+				u64 total = 0;
+
+				for (const auto& count : stats.fails)
+				{
+					total += count;
+				}
+
+				lines.emplace_back(total, &stats);
+			}
+		}
+
+		std::sort(lines.begin(), lines.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+		for (usz i = 0; i < std::min<usz>(lines.size(), 16); i++)
+		{
+			const auto& stats = *lines[i].second;
+			const auto& fails = stats.fails;
+
+			vm_log.notice("Reservation contention #%u: line 0x%08x: %u failures (lost: %u, locked: %u, data: %u, lock wait: %u)", i + 1, stats.addr - 1, lines[i].first, fails[0], fails[1], fails[2], fails[3]);
+		}
+
+		for (auto& stats : s_rsrv_stats)
+		{
+			stats.addr.release(0);
+			stats.window.release(0);
+			stats.score.release(0);
+
+			for (auto& count : stats.fails)
+			{
+				count.release(0);
+			}
+		}
+	}
+
 	u64 reservation_lock_internal(u32 addr, atomic_t<u64>& res)
 	{
+		reservation_contention(addr, reservation_fail::lock_wait);
+
 		for (u64 i = 0;; i++)
 		{
 			if (u64 rtime = res; !(rtime & 127) && reservation_try_lock(res, rtime)) [[likely]]
@@ -1662,6 +1785,11 @@ namespace vm
 		return 0;
 	}
 
+	std::string block_t::get_shared_path() const
+	{
+		return m_common ? m_common->get_shared_path() : std::string{};
+	}
+
 	static bool check_cache_line_zero(const void* ptr)
 	{
 		const auto p = reinterpret_cast<const v128*>(ptr);
@@ -2263,6 +2391,8 @@ namespace vm
 
 	void close()
 	{
+		reservation_contention_report();
+
 		{
 			vm::writer_lock lock;
 
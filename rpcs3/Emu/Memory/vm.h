@@ -203,6 +203,9 @@ namespace vm
 		// Returns sample address for shared memory, 0 on failure
 		u32 get_shm_addr(const std::shared_ptr<utils::shm>& shared);
 
+		// Returns the path to the memory backing a preallocated block for external tools (empty if unavailable)
+		std::string get_shared_path() const;
+
 		// Serialization
 		void save(utils::serial& ar, std::map<utils::shm*, usz>& shared);
 		block_t(utils::serial& ar, std::vector<std::shared_ptr<utils::shm>>& shared);
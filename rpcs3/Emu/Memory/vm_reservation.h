@@ -105,6 +105,26 @@ namespace vm
 
 	u64 reservation_lock_internal(u32, atomic_t<u64>&);
 
+	// Reasons of reservation contention
+	enum class reservation_fail : u32
+	{
+		lost, // Reservation time changed before the conditional store
+		locked, // Another thread was storing to the line
+		data, // Data changed under the lock
+		lock_wait, // Waited for another thread to unlock the line
+
+		__count
+	};
+
+	// Record contention on a 128-byte line (if enabled by "Reservation Contention Statistics" or "Reservation Adaptive Backoff")
+	void reservation_contention(u32 addr, reservation_fail reason);
+
+	// Delay the retry of a failed conditional store depending on recent contention of the line
+	void reservation_backoff(u32 addr);
+
+	// Log the most contended lines and reset the statistics
+	void reservation_contention_report();
+
 	void reservation_shared_lock_internal(atomic_t<u64>&);
 
 	inline bool reservation_try_lock(atomic_t<u64>& res, u64 rtime)
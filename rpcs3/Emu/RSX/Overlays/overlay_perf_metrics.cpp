@@ -10,6 +10,7 @@
 #include <utility>
 
 #include "util/cpu_stats.hpp"
+#include "util/tsc.hpp"
 
 namespace rsx
 {
@@ -528,6 +529,30 @@ namespace rsx
 
 						m_total_threads = utils::cpu_stats::get_current_thread_count();
 
+						const u64 tsc = utils::get_tsc();
+						const u64 tsc_diff = m_last_tsc && tsc > m_last_tsc ? tsc - m_last_tsc : 0;
+
+						std::unordered_map<u32, u64> ppu_busy;
+						u64 busiest_diff = 0;
+
+						m_busiest_ppu.clear();
+
+						idm::select<named_thread<ppu_thread>>([&](u32 id, named_thread<ppu_thread>& ppu)
+						{
+							const u64 busy = ppu.get_busy_time();
+							ppu_busy.emplace(id, busy);
+
+							if (const auto found = m_ppu_busy.find(id); found != m_ppu_busy.end() && busy >= found->second && busy - found->second >= busiest_diff)
+							{
+								busiest_diff = busy - found->second;
+								m_busiest_ppu = *ppu.ppu_tname.load();
+							}
+						});
+
+						m_ppu_busy = std::move(ppu_busy);
+						m_last_tsc = tsc;
+						m_busiest_ppu_usage = tsc_diff ? std::clamp(busiest_diff * 100.f / tsc_diff, 0.f, 100.f) : 0.f;
+
 						[[fallthrough]];
 					}
 					case detail_level::medium:
@@ -620,6 +645,11 @@ namespace rsx
 					                         "%s\n"
 					                         " RSX   : %02u %%",
 					    m_fps, m_frametime, std::string(title1_high.size(), ' '), m_ppu_usage, m_ppus, m_spu_usage, m_spus, m_rsx_usage, m_cpu_usage, m_total_threads, std::string(title2.size(), ' '), m_rsx_load);
+
+					if (!m_busiest_ppu.empty())
+					{
+						fmt::append(perf_text, "\n PPU   : %04.1f %% (%s)", m_busiest_ppu_usage, m_busiest_ppu);
+					}
 					break;
 				}
 				}
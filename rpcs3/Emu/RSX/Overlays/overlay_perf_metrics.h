@@ -4,6 +4,8 @@
 #include "util/cpu_stats.hpp"
 #include "Emu/system_config_types.h"
 
+#include <unordered_map>
+
 namespace rsx
 {
 	namespace overlays
@@ -80,6 +82,12 @@ namespace rsx
 			f32 m_rsx_usage{0};
 			u32 m_rsx_load{0};
 
+			// Busiest PPU thread by guest time accounting (syscall waits excluded)
+			std::unordered_map<u32, u64> m_ppu_busy; // Busy time by thread ID at the last update
+			u64 m_last_tsc{0};
+			std::string m_busiest_ppu;
+			f32 m_busiest_ppu_usage{0};
+
 			void reset_transform(label& elm) const;
 			void reset_transforms();
 			void reset_body();
@@ -41,6 +41,7 @@ atomic_t<bool> g_user_asked_for_recording = false;
 atomic_t<bool> g_user_asked_for_screenshot = false;
 atomic_t<bool> g_user_asked_for_frame_capture = false;
 atomic_t<bool> g_disable_frame_limit = false;
+atomic_t<u32> g_emu_flip_count = 0;
 rsx::frame_trace_data frame_debug;
 rsx::frame_capture_data frame_capture;
 
@@ -2488,6 +2489,8 @@ namespace rsx
 		if (info.emu_flip)
 		{
 			performance_counters.sampled_frames++;
+			g_emu_flip_count++;
+			g_emu_flip_count.notify_all();
 
 			if (m_pause_after_x_flips && m_pause_after_x_flips-- == 1)
 			{
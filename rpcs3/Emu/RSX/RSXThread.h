@@ -33,6 +33,7 @@
 
 extern atomic_t<bool> g_user_asked_for_frame_capture;
 extern atomic_t<bool> g_disable_frame_limit;
+extern atomic_t<u32> g_emu_flip_count; // Emulated flips since startup, waitable (outlives the renderer)
 extern rsx::frame_trace_data frame_debug;
 extern rsx::frame_capture_data frame_capture;
 
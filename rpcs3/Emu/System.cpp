@@ -35,6 +35,7 @@
 #include "Loader/PSF.h"
 #include "Loader/TAR.h"
 #include "Loader/ISO.h"
+#include "Loader/game_index.h"
 #include "Loader/ELF.h"
 #include "Loader/disc.h"
 
@@ -1788,6 +1789,8 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 				}
 			}
 
+			m_precompile_completed = false;
+
 			g_fxo->init<named_thread>("SPRX Loader"sv, [this, dir_queue, is_fast = m_precompilation_option.is_fast]() mutable
 			{
 				std::vector<ppu_module<lv2_obj>*> mod_list;
@@ -1818,6 +1821,13 @@ game_boot_result Emulator::Load(const std::string& title_id, bool is_disc_patch,
 
 				spu_cache::initialize(false);
 
+				if (Emu.IsStopped())
+				{
+					return;
+				}
+
+				m_precompile_completed = true;
+
 				// Exit "process"
 				CallFromMainThread([this]
 				{
@@ -4196,6 +4206,22 @@ u32 Emulator::AddGamesFromDir(const std::string& path)
 		entries.emplace_back(std::move(dir_entry));
 	}
 
+	// Refresh the game index of all candidates on multiple threads, AddGame below then only hits the index
+	std::vector<std::string> index_paths;
+
+	for (const fs::dir_entry& dir_entry : entries)
+	{
+		if (dir_entry.name == "." || dir_entry.name == "..")
+		{
+			continue;
+		}
+
+		const std::string dir_path = path + '/' + dir_entry.name;
+		index_paths.emplace_back(dir_entry.is_directory ? rpcs3::utils::get_sfo_dir_from_game_path(dir_path) + "/PARAM.SFO" : dir_path);
+	}
+
+	game_index::scan(index_paths);
+
 	auto path_it = entries.begin();
 
 	qt_events_aware_op(0, [&]()
@@ -4314,17 +4340,13 @@ game_boot_result Emulator::AddGameToYml(const std::string& path)
 		return error;
 	}
 
-	std::unique_ptr<iso_archive> archive;
-	if (is_file_iso(path))
-	{
-		archive = std::make_unique<iso_archive>(path);
-	}
+	const bool is_iso = is_file_iso(path);
 
-	// Load PARAM.SFO
+	// Load PARAM.SFO (through the game index, which avoids walking the ISO filesystem again)
 	const std::string elf_dir = fs::get_parent_dir(path);
-	std::string sfo_dir = archive ? "PS3_GAME" : rpcs3::utils::get_sfo_dir_from_game_path(fs::get_parent_dir(elf_dir));
+	std::string sfo_dir = is_iso ? "PS3_GAME" : rpcs3::utils::get_sfo_dir_from_game_path(fs::get_parent_dir(elf_dir));
 	const std::string sfo_path = sfo_dir + "/PARAM.SFO";
-	const psf::registry _psf = archive ? archive->open_psf(sfo_path) : psf::load_object(sfo_path);
+	const psf::registry _psf = game_index::load_psf(is_iso ? path : sfo_path);
 
 	const std::string title_id = std::string(psf::get_string(_psf, "TITLE_ID"));
 	const std::string cat = std::string(psf::get_string(_psf, "CATEGORY"));
@@ -4348,7 +4370,7 @@ game_boot_result Emulator::AddGameToYml(const std::string& path)
 	}
 
 	// Add ISO game
-	if (archive)
+	if (is_iso)
 	{
 		if (cat == "DG")
 		{
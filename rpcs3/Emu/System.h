@@ -196,6 +196,7 @@ class Emulator final
 
 	bs_t<SaveStateExtentionFlags1> m_savestate_extension_flags1{};
 	emu_precompilation_option_t m_precompilation_option{};
+	atomic_t<bool> m_precompile_completed = false; // Set when a directory boot has created all caches without being stopped
 
 public:
 	static constexpr std::string_view game_id_boot_prefix = "%RPCS3_GAMEID%:";
@@ -260,6 +261,11 @@ public:
 		m_precompilation_option = option;
 	}
 
+	bool IsPrecompileCompleted() const
+	{
+		return m_precompile_completed;
+	}
+
 	void Init();
 
 	std::vector<std::string> argv;
@@ -0,0 +1,130 @@
+#include "stdafx.h"
+#include "cache_builder.hpp"
+#include "System.h"
+#include "Utilities/StrUtil.h"
+
+#include <set>
+
+LOG_CHANNEL(sys_log, "SYS");
+
+static bool is_title_dir(const std::string& dir)
+{
+	return fs::is_file(dir + "/PARAM.SFO") || fs::is_file(dir + "/PS3_GAME/PARAM.SFO");
+}
+
+cache_builder::cache_builder(const std::vector<std::string>& dirs, std::string progress_path)
+	: m_progress_path(std::move(progress_path))
+{
+	std::set<std::string> finished;
+
+	if (const fs::file progress{m_progress_path})
+	{
+		for (const std::string& line : fmt::split(progress.to_string(), {"\n"}))
+		{
+			finished.emplace(line);
+		}
+	}
+
+	const auto enqueue = [&](std::string dir)
+	{
+		if (finished.contains(dir))
+		{
+			sys_log.notice("Cache builder: Skipping finished title: %s", dir);
+			return;
+		}
+
+		m_queue.emplace_back(std::move(dir));
+	};
+
+	for (std::string dir : dirs)
+	{
+		while (dir.size() > 1 && (dir.back() == '/' || dir.back() == '\\'))
+		{
+			dir.pop_back();
+		}
+
+		if (is_title_dir(dir))
+		{
+			enqueue(std::move(dir));
+			continue;
+		}
+
+		std::vector<std::string> titles;
+
+		for (const auto& entry : fs::dir(dir))
+		{
+			if (entry.is_directory && entry.name != "." && entry.name != ".." && is_title_dir(dir + '/' + entry.name))
+			{
+				titles.emplace_back(dir + '/' + entry.name);
+			}
+		}
+
+		if (titles.empty())
+		{
+			sys_log.error("Cache builder: No titles found in '%s'", dir);
+		}
+
+		std::sort(titles.begin(), titles.end());
+
+		for (std::string& title : titles)
+		{
+			enqueue(std::move(title));
+		}
+	}
+
+	sys_log.notice("Cache builder: %u title(s) queued, %u already finished", m_queue.size(), finished.size());
+}
+
+bool cache_builder::step()
+{
+	if (!Emu.IsStopped(true))
+	{
+		return true;
+	}
+
+	if (m_booted)
+	{
+		// Directory boots stop on their own once PPU modules and discovered SPU programs are compiled
+		m_booted = false;
+
+		const std::string& dir = ::at32(m_queue, m_index++);
+
+		if (!Emu.IsPrecompileCompleted())
+		{
+			// Stopped by an error: not recorded, so the title is retried on the next run
+			sys_log.error("Cache builder: Cache creation of %s did not complete (%u/%u)", dir, m_index, m_queue.size());
+			m_failed++;
+		}
+		else if (fs::file progress{m_progress_path, fs::write + fs::create + fs::append}; !progress || !progress.write(dir + '\n'))
+		{
+			sys_log.error("Cache builder: Failed to update progress file '%s' (%s)", m_progress_path, fs::g_tls_error);
+		}
+		else
+		{
+			sys_log.success("Cache builder: Finished %s (%u/%u)", dir, m_index, m_queue.size());
+		}
+	}
+
+	while (m_index < m_queue.size())
+	{
+		const std::string& dir = m_queue[m_index];
+
+		sys_log.notice("Cache builder: Creating caches for %s (%u/%u)", dir, m_index + 1, m_queue.size());
+
+		Emu.SetForceBoot(true);
+		Emu.SetPrecompileCacheOption(emu_precompilation_option_t{});
+
+		if (const game_boot_result error = Emu.BootGame(dir, "", true); error != game_boot_result::no_errors)
+		{
+			sys_log.error("Cache builder: Could not create caches for %s, error: %s", dir, error);
+			m_failed++;
+			m_index++;
+			continue;
+		}
+
+		m_booted = true;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// Headless batch creation of PPU and SPU caches, one title at a time.
+// Finished titles are recorded in a progress file, so an interrupted run resumes where it stopped.
+class cache_builder
+{
+	std::vector<std::string> m_queue;
+	std::string m_progress_path;
+	usz m_index = 0;
+	usz m_failed = 0;
+	bool m_booted = false;
+
+public:
+	// Each directory is either a title directory or a directory of title directories
+	cache_builder(const std::vector<std::string>& dirs, std::string progress_path);
+
+	// Boot the next title when the emulator is idle (must be called from the main thread), returns false when all are done
+	bool step();
+
+	usz size() const
+	{
+		return m_queue.size();
+	}
+
+	usz failed() const
+	{
+		return m_failed;
+	}
+};
@@ -23,6 +23,10 @@ struct cfg_root : cfg::node
 		cfg::_int<0, 1024> llvm_threads{ this, "Max LLVM Compile Threads", 0 };
 		cfg::_bool ppu_llvm_greedy_mode{ this, "PPU LLVM Greedy Mode", false, false };
 		cfg::_bool llvm_precompilation{ this, "LLVM Precompilation", true };
+		cfg::_bool ppu_analysis_cache{ this, "PPU Analysis Cache", true }; // Reuse PPU module analysis results from previous boots
+		cfg::_bool ppu_llvm_hotness_order{ this, "PPU LLVM Hotness Guided Compilation", false }; // Compile the most executed code of previous runs first
+		cfg::_bool ppu_llvm_tiered{ this, "PPU LLVM Tiered Compilation", false }; // Start on the interpreter while modules are compiled in the background
+		cfg::string llvm_shared_store{ this, "Shared LLVM Cache Store" }; // Directory of decompressed PPU objects shared between emulator instances (empty = disabled)
 		cfg::_enum<thread_scheduler_mode> thread_scheduler{this, "Thread Scheduler Mode", thread_scheduler_mode::os};
 		cfg::_bool set_daz_and_ftz{ this, "Set DAZ and FTZ", false };
 		cfg::_enum<spu_decoder_type> spu_decoder{ this, "SPU Decoder", spu_decoder_type::llvm };
@@ -41,6 +45,9 @@ struct cfg_root : cfg::node
 		cfg::_bool spu_accurate_reservations{ this, "Accurate SPU Reservations", true };
 		cfg::_bool accurate_cache_line_stores{ this, "Accurate Cache Line Stores", false };
 		cfg::_bool rsx_accurate_res_access{this, "Accurate RSX reservation access", false, true};
+		cfg::_bool reservation_contention_stats{ this, "Reservation Contention Statistics", false, true }; // Log the most contended reservation lines on stop
+		cfg::_bool reservation_adaptive_backoff{ this, "Reservation Adaptive Backoff", false, true }; // Delay conditional store retries on heavily contended lines
+		cfg::_bool suspend_all_stats{ this, "Suspend All Statistics", false, true }; // Log the call sites which pause all CPU threads the longest on stop
 
 		struct fifo_setting : public cfg::_enum<rsx_fifo_mode>
 		{
@@ -58,6 +65,7 @@ struct cfg_root : cfg::node
 		cfg::_bool spu_cache{ this, "SPU Cache", true };
 		cfg::_bool spu_prof{ this, "SPU Profiler", false };
 		cfg::_bool ppu_prof{ this, "PPU Profiler", false };
+		cfg::_bool ppu_time_stats{ this, "PPU Thread Time Statistics", false }; // Save per-thread syscall wait and suspension times on stop
 		cfg::uint<0, 16> mfc_transfers_shuffling{ this, "MFC Commands Shuffling Limit", 0 };
 		cfg::uint<0, 10000> mfc_transfers_timeout{ this, "MFC Commands Timeout", 0, true };
 		cfg::_bool mfc_shuffling_in_steps{ this, "MFC Commands Shuffling In Steps", false, true };
@@ -91,6 +99,9 @@ struct cfg_root : cfg::node
 		cfg::_enum<sleep_timers_accuracy_level> sleep_timers_accuracy{ this, "Sleep Timers Accuracy", sleep_timers_accuracy_level::_usleep, true };
 #endif
 		cfg::_int<-1000, 1500> usleep_addend{ this, "Usleep Time Addend", 0, true };
+		cfg::_int<0, 16> vdec_threads{ this, "Video Decoder Threads", 0 }; // 0 = automatic, 1 = single-threaded
+		cfg::_bool vdec_frame_threading{ this, "Video Decoder Frame Threading", false }; // Decode consecutive pictures in parallel, delays each picture by up to (threads - 1) AUs
+		cfg::_int<1, 8> vdec_color_conversion_threads{ this, "Video Color Conversion Threads", 1, true }; // Threads used to convert decoded pictures to RGB (cellVdec and cellVpost)
 
 		cfg::uint64 perf_report_threshold{this, "Performance Report Threshold", 500, true}; // In µs, 0.5ms = default, 0 = everything
 		cfg::_bool perf_report{this, "Enable Performance Report", false, true}; // Show certain perf-related logs
@@ -107,6 +118,7 @@ struct cfg_root : cfg::node
 		cfg::_bool limit_cache_size{ this, "Limit disk cache size", false };
 		cfg::_int<0, 10240> cache_max_size{ this, "Disk cache maximum size (MB)", 5120 };
 		cfg::_bool empty_hdd0_tmp{ this, "Empty /dev_hdd0/tmp/", true };
+		cfg::_bool pkg_presize{ this, "Presize PKG install files", true }; // Set the final size of large PKG entries before writing them in parallel (sparse, disk space is not reserved)
 
 	} vfs{ this };
 
@@ -253,6 +265,7 @@ struct cfg_root : cfg::node
 		cfg::_bool enable_time_stretching{ this, "Enable Time Stretching", false, true };
 		cfg::_bool disable_sampling_skip{ this, "Disable Sampling Skip", false, true };
 		cfg::_int<0, 100> time_stretching_threshold{ this, "Time Stretching Threshold", 75, true };
+		cfg::_enum<audio_resampler_type> time_stretching_resampler{ this, "Time Stretching Resampler", audio_resampler_type::soundtouch, true };
 		cfg::_enum<microphone_handler> microphone_type{ this, "Microphone Type", microphone_handler::null };
 		cfg::string microphone_devices{ this, "Microphone Devices", "@@@@@@@@@@@@" };
 		cfg::_enum<music_handler> music{ this, "Music Handler", music_handler::qt };
@@ -144,6 +144,21 @@ void fmt_class_string<audio_channel_layout>::format(std::string& out, u64 arg)
 	});
 }
 
+template <>
+void fmt_class_string<audio_resampler_type>::format(std::string& out, u64 arg)
+{
+	format_enum(out, arg, [](audio_resampler_type value)
+	{
+		switch (value)
+		{
+		case audio_resampler_type::soundtouch: return "SoundTouch";
+		case audio_resampler_type::sinc: return "Windowed Sinc";
+		}
+
+		return unknown;
+	});
+}
+
 template <>
 void fmt_class_string<detail_level>::format(std::string& out, u64 arg)
 {
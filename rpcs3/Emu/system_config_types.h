@@ -106,6 +106,12 @@ enum class audio_channel_layout
 	surround_7_1,
 };
 
+enum class audio_resampler_type
+{
+	soundtouch,
+	sinc,
+};
+
 enum class music_handler
 {
 	null,
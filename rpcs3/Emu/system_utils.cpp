@@ -15,6 +15,12 @@
 #include <charconv>
 #include <thread>
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#endif
+
 LOG_CHANNEL(sys_log, "SYS");
 
 namespace rpcs3::utils
@@ -68,14 +74,40 @@ namespace rpcs3::utils
 		return id;
 	}
 
-	bool install_pkg(const std::string& path)
+	bool install_pkg(const std::string& path, bool streaming, u32 stream_timeout)
 	{
-		sys_log.success("Installing package: %s", path);
+		sys_log.success("Installing package: %s%s", path, streaming ? " (streaming)" : "");
 
 		int int_progress = 0;
 
+		fs::file file;
+
+		if (streaming && path == "-")
+		{
+			// The file takes ownership of the handle, so give it a duplicate of the standard input
+#ifdef _WIN32
+			HANDLE handle{};
+
+			if (DuplicateHandle(GetCurrentProcess(), GetStdHandle(STD_INPUT_HANDLE), GetCurrentProcess(), &handle, 0, FALSE, DUPLICATE_SAME_ACCESS))
+			{
+				file = fs::file::from_native_handle(handle);
+			}
+#else
+			if (const int fd = ::dup(STDIN_FILENO); fd >= 0)
+			{
+				file = fs::file::from_native_handle(fd);
+			}
+#endif
+
+			if (!file)
+			{
+				sys_log.error("Failed to open the standard input for package streaming");
+				return false;
+			}
+		}
+
 		std::deque<package_reader> reader;
-		reader.emplace_back(path);
+		reader.emplace_back(path, std::move(file), streaming, stream_timeout);
 
 		// Run PKG unpacking asynchronously
 		named_thread worker("PKG Installer", [&]
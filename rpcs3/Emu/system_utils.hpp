@@ -23,7 +23,9 @@ namespace rpcs3::utils
 
 	u32 check_user(const std::string& user);
 
-	bool install_pkg(const std::string& path);
+	// Streaming mode installs while the package is being received ("-" reads from the standard input)
+	// stream_timeout: seconds without new data before failing (0: no timeout)
+	bool install_pkg(const std::string& path, bool streaming = false, u32 stream_timeout = 10);
 
 	// VFS directories and disk usage
 	std::vector<std::pair<std::string, u64>> get_vfs_disk_usage();
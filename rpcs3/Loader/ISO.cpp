@@ -1,8 +1,11 @@
 #include "stdafx.h"
 
 #include "ISO.h"
+#include "iso_compressed.h"
 #include "Emu/VFS.h"
 #include "Crypto/utils.h"
+#include "Utilities/Thread.h"
+#include "util/vm.hpp"
 
 #include <codecvt>
 #include <algorithm>
@@ -30,7 +33,7 @@ bool is_file_iso(const std::string& path)
 	if (path.empty()) return false;
 	if (fs::is_dir(path)) return false;
 
-	return is_file_iso(fs::file(path));
+	return is_file_iso(open_iso_image(path));
 }
 
 bool is_file_iso(const fs::file& file)
@@ -170,7 +173,7 @@ bool iso_file_decryption::init(const std::string& path)
 	// Store the ISO region information (needed by both the "Redump" type (only on "decrypt()" method) and "3k3y" type)
 	//
 
-	fs::file iso_file(path);
+	fs::file iso_file = open_iso_image(path);
 
 	if (!iso_file)
 	{
@@ -394,6 +397,199 @@ bool iso_file_decryption::decrypt(u64 offset, void* buffer, u64 size, const std:
 	return true;
 }
 
+iso_block_cache::iso_block_cache(const std::string& path, std::shared_ptr<iso_file_decryption> iso_dec)
+	: m_path(path)
+	, m_file(open_iso_image(path))
+	, m_dec(std::move(iso_dec))
+{
+	if (!m_file)
+	{
+		return;
+	}
+
+	m_size = m_file.size();
+
+	if (m_size && m_dec->get_enc_type() == iso_encryption_type::NONE)
+	{
+		// Nothing to decrypt: let the OS page cache do the work (may be unsupported on the platform)
+		// Compressed images have no native handle and always go through the block cache
+		m_map = static_cast<u8*>(utils::memory_map_fd(m_file.get_handle(), m_size, utils::protection::ro));
+	}
+
+	if (m_map)
+	{
+		sys_log.notice("ISO block cache: mapped '%s' (size=0x%x)", m_path, m_size);
+		return;
+	}
+
+	m_read_ahead_thread = std::make_unique<named_thread<std::function<void()>>>("ISO Read-ahead"sv, [this]()
+	{
+		while (true)
+		{
+			m_read_ahead_queue.wait();
+
+			for (u64 index : m_read_ahead_queue.pop_all())
+			{
+				if (index == umax)
+				{
+					return;
+				}
+
+				get_block(index);
+				m_read_ahead_pending--;
+			}
+		}
+	});
+}
+
+iso_block_cache::~iso_block_cache()
+{
+	if (m_read_ahead_thread)
+	{
+		// Exit signal
+		m_read_ahead_queue.push(umax);
+		m_read_ahead_thread.reset();
+	}
+
+	if (m_map)
+	{
+		utils::memory_release(m_map, m_size);
+	}
+}
+
+iso_block_cache::block_ptr iso_block_cache::load_block(u64 index)
+{
+	const u64 pos = index * block_size;
+
+	if (pos >= m_size)
+	{
+		return nullptr;
+	}
+
+	auto data = std::make_shared<std::vector<u8>>(std::min(block_size, m_size - pos));
+
+	if (m_file.read_at(pos, data->data(), data->size()) != data->size())
+	{
+		sys_log.error("ISO block cache: failed to read block 0x%x of '%s'", index, m_path);
+		return nullptr;
+	}
+
+	// Decrypt sector by sector since a block may cross encrypted region boundaries
+	for (u64 offset = 0; offset < data->size(); offset += ISO_SECTOR_SIZE)
+	{
+		const u64 sector_size = std::min(ISO_SECTOR_SIZE, data->size() - offset) & ~u64{15};
+
+		if (sector_size)
+		{
+			m_dec->decrypt(pos + offset, data->data() + offset, sector_size, m_path);
+		}
+	}
+
+	return data;
+}
+
+iso_block_cache::block_ptr iso_block_cache::get_block(u64 index)
+{
+	{
+		std::lock_guard lock(m_mutex);
+
+		if (auto found = m_blocks.find(index); found != m_blocks.end())
+		{
+			m_lru.splice(m_lru.begin(), m_lru, found->second.second);
+			return found->second.first;
+		}
+	}
+
+	// Load without holding the lock, another thread may load the same block concurrently
+	block_ptr data = load_block(index);
+
+	if (!data)
+	{
+		return nullptr;
+	}
+
+	std::lock_guard lock(m_mutex);
+
+	if (auto found = m_blocks.find(index); found != m_blocks.end())
+	{
+		// Loaded concurrently by another thread
+		m_lru.splice(m_lru.begin(), m_lru, found->second.second);
+		return found->second.first;
+	}
+
+	if (m_blocks.size() >= max_blocks)
+	{
+		// Evict the least recently used block
+		m_blocks.erase(m_lru.back());
+		m_lru.pop_back();
+	}
+
+	m_lru.push_front(index);
+	m_blocks.emplace(index, std::make_pair(data, m_lru.begin()));
+	return data;
+}
+
+u64 iso_block_cache::read_at(u64 offset, void* buffer, u64 size)
+{
+	if (offset >= m_size || !size)
+	{
+		return 0;
+	}
+
+	size = std::min(size, m_size - offset);
+
+	if (m_map)
+	{
+		std::memcpy(buffer, m_map + offset, size);
+		return size;
+	}
+
+	if (size >= direct_read_size && m_dec->get_enc_type() == iso_encryption_type::NONE)
+	{
+		// Nothing to decrypt and little to gain from caching (compressed images decompress large reads on multiple threads)
+		return m_file.read_at(offset, buffer, size);
+	}
+
+	u64 total_read = 0;
+	u64 index = offset / block_size;
+
+	for (; total_read < size; index++)
+	{
+		const block_ptr block = get_block(index);
+		const u64 block_offset = (offset + total_read) % block_size;
+
+		if (!block || block->size() <= block_offset)
+		{
+			break;
+		}
+
+		const u64 count = std::min(size - total_read, block->size() - block_offset);
+
+		std::memcpy(static_cast<u8*>(buffer) + total_read, block->data() + block_offset, count);
+		total_read += count;
+	}
+
+	const u64 last_block = (offset + std::max<u64>(total_read, 1) - 1) / block_size;
+	const u64 prev_block = m_last_block.exchange(last_block);
+
+	// Sequential access reaching a new block: load the following blocks in the background
+	if (m_read_ahead_thread && prev_block != umax && offset / block_size <= prev_block + 1 && last_block > prev_block)
+	{
+		for (u64 i = 1; i <= read_ahead_blocks; i++)
+		{
+			// Don't let the queue grow when the read-ahead thread falls behind
+			if (!m_read_ahead_pending.try_inc(max_read_ahead_pending))
+			{
+				break;
+			}
+
+			m_read_ahead_queue.push(last_block + i);
+		}
+	}
+
+	return total_read;
+}
+
 template<typename T>
 inline T retrieve_endian_int(const u8* buf)
 {
@@ -613,7 +809,7 @@ u64 iso_fs_metadata::size() const
 iso_archive::iso_archive(const std::string& path)
 {
 	m_path = path;
-	m_file = fs::file(path);
+	m_file = open_iso_image(path);
 	m_dec = std::make_shared<iso_file_decryption>();
 
 	if (!m_dec->init(path))
@@ -734,7 +930,7 @@ bool iso_archive::is_file(const std::string& path)
 
 iso_file iso_archive::open(const std::string& path)
 {
-	return iso_file(fs::file(m_path), m_dec, *ensure(retrieve(path)));
+	return iso_file(open_iso_image(m_path), m_dec, *ensure(retrieve(path)));
 }
 
 psf::registry iso_archive::open_psf(const std::string& path)
@@ -746,13 +942,13 @@ psf::registry iso_archive::open_psf(const std::string& path)
 		return psf::registry();
 	}
 
-	const fs::file psf_file(std::make_unique<iso_file>(fs::file(m_path), m_dec, *archive_file));
+	const fs::file psf_file(std::make_unique<iso_file>(open_iso_image(m_path), m_dec, *archive_file));
 
 	return psf::load_object(psf_file, path);
 }
 
-iso_file::iso_file(fs::file&& iso_handle, std::shared_ptr<iso_file_decryption> iso_dec, const iso_fs_node& node)
-	: m_file(std::move(iso_handle)), m_dec(iso_dec), m_meta(node.metadata)
+iso_file::iso_file(fs::file&& iso_handle, std::shared_ptr<iso_file_decryption> iso_dec, const iso_fs_node& node, std::shared_ptr<iso_block_cache> cache)
+	: m_file(std::move(iso_handle)), m_dec(iso_dec), m_cache(std::move(cache)), m_meta(node.metadata)
 {
 	m_file.seek(node.metadata.extents[0].start * ISO_SECTOR_SIZE);
 }
@@ -834,10 +1030,10 @@ u64 iso_file::read_at(u64 offset, void* buffer, u64 size)
 	const u64 total_size = this->size();
 	u64 total_read;
 
-	// If it's a non-encrypted type
-	if (m_dec->get_enc_type() == iso_encryption_type::NONE)
+	// If the ISO is mounted, decrypted data is read through the shared block cache
+	if (m_cache || m_dec->get_enc_type() == iso_encryption_type::NONE)
 	{
-		total_read = m_file.read_at(archive_first_offset, buffer, max_size);
+		total_read = m_cache ? m_cache->read_at(archive_first_offset, buffer, max_size) : m_file.read_at(archive_first_offset, buffer, max_size);
 
 		if (size > total_read && (offset + total_read) < total_size)
 		{
@@ -1093,7 +1289,7 @@ std::unique_ptr<fs::file_base> iso_device::open(const std::string& path, bs_t<fs
 		return nullptr;
 	}
 
-	return std::make_unique<iso_file>(fs::file(m_path, mode), m_archive.get_dec(), *node);
+	return std::make_unique<iso_file>(open_iso_image(m_path, mode), m_archive.get_dec(), *node, m_cache);
 }
 
 std::unique_ptr<fs::dir_base> iso_device::open_dir(const std::string& path)
@@ -3,9 +3,18 @@
 #include "Loader/PSF.h"
 
 #include "Utilities/File.h"
+#include "Utilities/mutex.h"
+#include "Utilities/lockless.h"
 #include "util/types.hpp"
 #include "Crypto/aes.h"
 
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+template <typename T>
+class named_thread;
+
 bool is_file_iso(const std::string& path);
 bool is_file_iso(const fs::file& path);
 
@@ -64,6 +73,45 @@ public:
 	bool decrypt(u64 offset, void* buffer, u64 size, const std::string& name);
 };
 
+// Cache of decrypted ISO blocks shared by all the files opened from a mounted ISO.
+// Sequential reads trigger read-ahead of the next blocks on a background thread.
+// Unencrypted images are mapped in memory instead when possible.
+class iso_block_cache
+{
+public:
+	static constexpr u64 block_size = 0x10000; // Multiple of the sector size
+	static constexpr usz max_blocks = 512;
+	static constexpr u64 read_ahead_blocks = 8;
+	static constexpr u32 max_read_ahead_pending = 32; // Limit of queued read-ahead blocks
+	static constexpr u64 direct_read_size = 0x200000; // Large reads of unencrypted images bypass the cache
+
+	iso_block_cache(const std::string& path, std::shared_ptr<iso_file_decryption> iso_dec);
+	~iso_block_cache();
+
+	u64 read_at(u64 offset, void* buffer, u64 size);
+
+private:
+	using block_ptr = std::shared_ptr<const std::vector<u8>>;
+
+	block_ptr get_block(u64 index);
+	block_ptr load_block(u64 index);
+
+	std::string m_path;
+	fs::file m_file;
+	u64 m_size = 0;
+	std::shared_ptr<iso_file_decryption> m_dec;
+	u8* m_map = nullptr;
+
+	shared_mutex m_mutex;
+	std::list<u64> m_lru; // Block indices, most recently used first
+	std::unordered_map<u64, std::pair<block_ptr, std::list<u64>::iterator>> m_blocks; // Block index -> (data, position in m_lru)
+	atomic_t<u64> m_last_block = umax;
+
+	lf_queue<u64> m_read_ahead_queue;
+	atomic_t<u32> m_read_ahead_pending = 0;
+	std::unique_ptr<named_thread<std::function<void()>>> m_read_ahead_thread;
+};
+
 struct iso_extent_info
 {
 	u64 start = 0;
@@ -92,6 +140,7 @@ class iso_file : public fs::file_base
 private:
 	fs::file m_file;
 	std::shared_ptr<iso_file_decryption> m_dec;
+	std::shared_ptr<iso_block_cache> m_cache;
 	iso_fs_metadata m_meta;
 	u64 m_pos = 0;
 
@@ -101,7 +150,7 @@ private:
 	u64 file_offset(u64 pos) const;
 
 public:
-	iso_file(fs::file&& iso_handle, std::shared_ptr<iso_file_decryption> iso_dec, const iso_fs_node& node);
+	iso_file(fs::file&& iso_handle, std::shared_ptr<iso_file_decryption> iso_dec, const iso_fs_node& node, std::shared_ptr<iso_block_cache> cache = nullptr);
 
 	fs::stat_t get_stat() override;
 	bool trunc(u64 length) override;
@@ -157,12 +206,13 @@ class iso_device : public fs::device_base
 private:
 	std::string m_path;
 	iso_archive m_archive;
+	std::shared_ptr<iso_block_cache> m_cache;
 
 public:
 	inline static std::string virtual_device_name = "/vfsv0_virtual_iso_overlay_fs_dev";
 
 	iso_device(const std::string& iso_path, const std::string& device_name = virtual_device_name)
-		: m_path(iso_path), m_archive(iso_path)
+		: m_path(iso_path), m_archive(iso_path), m_cache(std::make_shared<iso_block_cache>(iso_path, m_archive.get_dec()))
 	{
 		fs_prefix = device_name;
 	}
@@ -0,0 +1,407 @@
+#include "stdafx.h"
+
+#include "game_index.h"
+#include "Loader/ISO.h"
+#include "Utilities/File.h"
+#include "Utilities/mutex.h"
+#include "Utilities/Thread.h"
+#include "util/fnv_hash.hpp"
+#include "util/sysinfo.hpp"
+
+#include <unordered_map>
+
+LOG_CHANNEL(game_index_log, "GameIndex");
+
+namespace
+{
+	constexpr char c_index_magic[4] = {'R', 'G', 'I', 'X'};
+	constexpr u32 c_index_version = 2;
+
+	struct index_state
+	{
+		shared_mutex mutex;
+		std::unordered_map<std::string, game_index_entry> entries;
+		bool loaded = false;
+		u64 revision = 0;
+		u64 saved_revision = 0;
+	};
+
+	index_state& get_state()
+	{
+		static index_state s_state;
+		return s_state;
+	}
+
+	std::string get_index_dir()
+	{
+		const std::string dir = fs::get_cache_dir() + "cache/game_index/";
+		fs::create_path(dir);
+		return dir;
+	}
+
+	// FNV-64 hash of the game path used as the icon filename stem.
+	std::string get_icon_path(const std::string& path)
+	{
+		usz hash = rpcs3::fnv_seed;
+		for (const char c : path)
+		{
+			hash ^= static_cast<u8>(c);
+			hash *= rpcs3::fnv_prime;
+		}
+		return get_index_dir() + fmt::format("%016llx.png", hash);
+	}
+
+	bool is_up_to_date(const std::string& path, const game_index_entry& entry)
+	{
+		fs::stat_t stat{};
+		return fs::get_stat(path, stat) && !stat.is_directory && stat.mtime == entry.mtime && stat.size == entry.size;
+	}
+
+	template <typename T>
+	void write_value(std::vector<u8>& out, const T& value)
+	{
+		const u8* ptr = reinterpret_cast<const u8*>(&value);
+		out.insert(out.end(), ptr, ptr + sizeof(T));
+	}
+
+	template <typename T>
+	void write_bytes(std::vector<u8>& out, const T& data)
+	{
+		write_value(out, static_cast<u64>(data.size()));
+		out.insert(out.end(), data.begin(), data.end());
+	}
+
+	struct index_reader
+	{
+		const std::vector<u8>& data;
+		usz pos = 0;
+		bool ok = true;
+
+		template <typename T>
+		T read_value()
+		{
+			T value{};
+
+			if (!ok || data.size() - pos < sizeof(T))
+			{
+				ok = false;
+				return value;
+			}
+
+			std::memcpy(&value, data.data() + pos, sizeof(T));
+			pos += sizeof(T);
+			return value;
+		}
+
+		template <typename T>
+		T read_bytes()
+		{
+			const u64 size = read_value<u64>();
+
+			if (!ok || data.size() - pos < size)
+			{
+				ok = false;
+				return {};
+			}
+
+			T result(data.begin() + pos, data.begin() + pos + size);
+			pos += size;
+			return result;
+		}
+	};
+
+	// Must be called with the writer lock held
+	void load_index(index_state& state)
+	{
+		if (state.loaded)
+		{
+			return;
+		}
+
+		state.loaded = true;
+
+		// Superseded by the index
+		fs::remove_all(fs::get_cache_dir() + "cache/iso_cache/", true, true);
+
+		const fs::file index_file(get_index_dir() + "index.dat");
+
+		if (!index_file)
+		{
+			return;
+		}
+
+		const std::vector<u8> data = index_file.to_vector<u8>();
+		index_reader ar{data};
+
+		if (data.size() < sizeof(c_index_magic) || std::memcmp(data.data(), c_index_magic, sizeof(c_index_magic)) != 0)
+		{
+			game_index_log.warning("Invalid game index file, it will be rebuilt");
+			return;
+		}
+
+		ar.pos = sizeof(c_index_magic);
+
+		if (const u32 version = ar.read_value<u32>(); version != c_index_version)
+		{
+			game_index_log.notice("Game index version %u is outdated, it will be rebuilt", version);
+			return;
+		}
+
+		const u64 count = ar.read_value<u64>();
+
+		for (u64 i = 0; i < count && ar.ok; i++)
+		{
+			std::string path = ar.read_bytes<std::string>();
+
+			game_index_entry entry{};
+			entry.mtime      = ar.read_value<s64>();
+			entry.size       = ar.read_value<u64>();
+			entry.has_media  = ar.read_value<u8>() != 0;
+			const u32 media_count = ar.read_value<u32>();
+
+			for (u32 j = 0; j < media_count && ar.ok; j++)
+			{
+				entry.media_files.emplace_back(ar.read_bytes<std::string>());
+			}
+
+			entry.icon_path  = ar.read_bytes<std::string>();
+			entry.psf_data   = ar.read_bytes<std::vector<u8>>();
+
+			if (ar.ok)
+			{
+				state.entries.insert_or_assign(std::move(path), std::move(entry));
+			}
+		}
+
+		if (!ar.ok)
+		{
+			game_index_log.warning("Game index file is truncated, it will be rebuilt");
+			state.entries.clear();
+			return;
+		}
+
+		game_index_log.notice("Loaded %u game index entries", state.entries.size());
+	}
+
+	index_state& get_loaded_state()
+	{
+		index_state& state = get_state();
+
+		{
+			reader_lock lock(state.mutex);
+
+			if (state.loaded)
+			{
+				return state;
+			}
+		}
+
+		std::lock_guard lock(state.mutex);
+		load_index(state);
+		return state;
+	}
+}
+
+namespace game_index
+{
+	bool load(const std::string& path, game_index_entry& out_entry)
+	{
+		index_state& state = get_loaded_state();
+
+		{
+			reader_lock lock(state.mutex);
+
+			const auto found = state.entries.find(path);
+
+			if (found == state.entries.end())
+			{
+				return false;
+			}
+
+			out_entry = found->second;
+		}
+
+		// Reject stale entries.
+		return is_up_to_date(path, out_entry);
+	}
+
+	bool load_icon(const std::string& path, const std::string& icon_path, std::vector<u8>& out_data)
+	{
+		if (game_index_entry entry{}; !load(path, entry) || entry.icon_path != icon_path)
+		{
+			return false;
+		}
+
+		const fs::file png_file(get_icon_path(path));
+
+		if (!png_file)
+		{
+			return false;
+		}
+
+		out_data = png_file.to_vector<u8>();
+		return !out_data.empty();
+	}
+
+	void save(const std::string& path, game_index_entry entry)
+	{
+		fs::stat_t stat{};
+
+		if (!fs::get_stat(path, stat) || stat.is_directory)
+		{
+			return;
+		}
+
+		entry.mtime = stat.mtime;
+		entry.size = stat.size;
+
+		if (!entry.icon_data.empty())
+		{
+			if (fs::pending_file png_file(get_icon_path(path)); png_file.file)
+			{
+				png_file.file.write(entry.icon_data);
+				png_file.commit();
+			}
+
+			entry.icon_data.clear();
+		}
+
+		index_state& state = get_loaded_state();
+
+		std::lock_guard lock(state.mutex);
+		state.entries.insert_or_assign(path, std::move(entry));
+		state.revision++;
+	}
+
+	psf::registry load_psf(const std::string& path)
+	{
+		if (game_index_entry entry{}; load(path, entry) && !entry.psf_data.empty())
+		{
+			return psf::load_object(fs::make_stream<std::vector<u8>>(std::move(entry.psf_data)), path);
+		}
+
+		psf::registry psf;
+
+		if (is_file_iso(path))
+		{
+			psf = iso_archive(path).open_psf("PS3_GAME/PARAM.SFO");
+		}
+		else if (path.ends_with("/PARAM.SFO") && fs::is_file(path))
+		{
+			psf = psf::load_object(path);
+		}
+
+		if (!psf.empty())
+		{
+			game_index_entry entry{};
+			entry.psf_data = psf::save_object(psf);
+			save(path, std::move(entry));
+		}
+
+		return psf;
+	}
+
+	void scan(const std::vector<std::string>& paths)
+	{
+		if (paths.empty())
+		{
+			return;
+		}
+
+		atomic_t<usz> next = 0;
+
+		const auto worker = [&]()
+		{
+			for (usz i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1))
+			{
+				load_psf(paths[i]);
+			}
+		};
+
+		const u32 thread_count = static_cast<u32>(std::min<usz>(utils::get_thread_count(), paths.size()));
+
+		named_thread_group workers("Game Index Scanner "sv, thread_count - 1, [&]()
+		{
+			worker();
+		});
+
+		worker();
+		workers.join();
+
+		flush();
+	}
+
+	void cleanup(const std::unordered_set<std::string>& valid_paths)
+	{
+		index_state& state = get_loaded_state();
+
+		std::lock_guard lock(state.mutex);
+
+		for (auto it = state.entries.begin(); it != state.entries.end();)
+		{
+			if (valid_paths.contains(it->first))
+			{
+				++it;
+				continue;
+			}
+
+			fs::remove_file(get_icon_path(it->first));
+			it = state.entries.erase(it);
+			state.revision++;
+		}
+	}
+
+	void flush()
+	{
+		index_state& state = get_loaded_state();
+
+		std::vector<u8> data;
+		u64 revision = 0;
+
+		{
+			reader_lock lock(state.mutex);
+
+			if (state.revision == state.saved_revision)
+			{
+				return;
+			}
+
+			revision = state.revision;
+
+			data.insert(data.end(), std::begin(c_index_magic), std::end(c_index_magic));
+			write_value(data, c_index_version);
+			write_value(data, static_cast<u64>(state.entries.size()));
+
+			for (const auto& [path, entry] : state.entries)
+			{
+				write_bytes(data, path);
+				write_value(data, entry.mtime);
+				write_value(data, entry.size);
+				write_value(data, static_cast<u8>(entry.has_media));
+				write_value(data, static_cast<u32>(entry.media_files.size()));
+
+				for (const std::string& file : entry.media_files)
+				{
+					write_bytes(data, file);
+				}
+
+				write_bytes(data, entry.icon_path);
+				write_bytes(data, entry.psf_data);
+			}
+		}
+
+		if (fs::pending_file index_file(get_index_dir() + "index.dat"); index_file.file)
+		{
+			index_file.file.write(data);
+
+			if (index_file.commit())
+			{
+				std::lock_guard lock(state.mutex);
+				state.saved_revision = std::max(state.saved_revision, revision);
+				return;
+			}
+		}
+
+		game_index_log.error("Failed to write the game index (error=%s)", fs::g_tls_error);
+	}
+}
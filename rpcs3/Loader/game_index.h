@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Loader/PSF.h"
+#include "util/types.hpp"
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Persistent metadata of a game folder or ISO, shared by the game list and games.yml scanning.
+// Entries are keyed by the file which validates them: the ISO itself, or the PARAM.SFO of a folder game.
+struct game_index_entry
+{
+	s64 mtime = 0;
+	u64 size = 0;
+	std::vector<u8> psf_data{};
+	bool has_media = false; // The fields below were filled by the game list (ISO only)
+	std::vector<std::string> media_files{}; // Icons, hover movies and music found next to PARAM.SFO inside the ISO
+	std::string icon_path{}; // Path of icon_data inside the ISO
+	std::vector<u8> icon_data{}; // Icon extracted from the ISO, stored next to the index
+};
+
+namespace game_index
+{
+	// Returns false if no valid entry exists or the file has changed (icon data is not loaded).
+	bool load(const std::string& path, game_index_entry& out_entry);
+
+	// Load the cached icon extracted from an ISO, if it was extracted from icon_path.
+	bool load_icon(const std::string& path, const std::string& icon_path, std::vector<u8>& out_data);
+
+	// Add or replace an entry, the modification time and size are taken from the file.
+	void save(const std::string& path, game_index_entry entry);
+
+	// Load PARAM.SFO of an ISO or from a PARAM.SFO path, through the index when it is up to date.
+	psf::registry load_psf(const std::string& path);
+
+	// Refresh the entries of many ISOs or PARAM.SFO paths on multiple threads.
+	void scan(const std::vector<std::string>& paths);
+
+	// Remove entries for paths that are no longer in the scanned set.
+	void cleanup(const std::unordered_set<std::string>& valid_paths);
+
+	// Write the index to disk if it has changed.
+	void flush();
+}
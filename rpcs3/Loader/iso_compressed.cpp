@@ -0,0 +1,443 @@
+#include "stdafx.h"
+
+#include "iso_compressed.h"
+#include "Utilities/mutex.h"
+#include "Utilities/Thread.h"
+#include "util/asm.hpp"
+#include "util/sysinfo.hpp"
+
+#include <zstd.h>
+
+LOG_CHANNEL(sys_log, "SYS");
+
+namespace
+{
+	constexpr u32 c_version = 1;
+	constexpr u32 c_block_size = 0x10000;
+	constexpr u32 c_sector_size = 2048;
+	constexpr int c_compression_level = 9;
+	constexpr usz c_cached_blocks = 8;
+	constexpr u64 c_parallel_min_blocks = 32; // Large reads are decompressed on multiple threads
+
+	bool check_header(const compressed_iso_header& header, u64 file_size)
+	{
+		return std::memcmp(header.magic, "RCSO", 4) == 0
+			&& header.version == c_version
+			&& header.block_size && header.block_size % c_sector_size == 0
+			&& header.index_offset >= sizeof(compressed_iso_header)
+			&& header.index_offset <= file_size;
+	}
+
+	struct zstd_dctx_deleter
+	{
+		void operator()(ZSTD_DCtx* ctx) const
+		{
+			ZSTD_freeDCtx(ctx);
+		}
+	};
+
+	struct zstd_cctx_deleter
+	{
+		void operator()(ZSTD_CCtx* ctx) const
+		{
+			ZSTD_freeCCtx(ctx);
+		}
+	};
+
+	class compressed_iso_file final : public fs::file_base
+	{
+		fs::file m_file;
+		compressed_iso_header m_header;
+		u64 m_pos = 0;
+
+		// Small cache of decompressed blocks for reads which don't cover whole blocks
+		shared_mutex m_mutex;
+		std::array<std::pair<u64, std::vector<u8>>, c_cached_blocks> m_cache{};
+		usz m_cache_next = 0;
+
+		u64 block_size(u64 index) const
+		{
+			return std::min<u64>(m_header.block_size, m_header.image_size - index * m_header.block_size);
+		}
+
+		bool decompress_block(u64 index, u8* out) const
+		{
+			le_t<u64> range[2]{};
+
+			if (m_file.read_at(m_header.index_offset + index * sizeof(u64), range, sizeof(range)) != sizeof(range))
+			{
+				sys_log.error("Compressed ISO: failed to read the index of block 0x%x", index);
+				return false;
+			}
+
+			const u64 start = range[0];
+			const u64 end = range[1];
+			const u64 size = block_size(index);
+
+			if (end < start || end - start > size)
+			{
+				sys_log.error("Compressed ISO: invalid index of block 0x%x (start=0x%x, end=0x%x)", index, start, end);
+				return false;
+			}
+
+			if (end - start == size)
+			{
+				// Stored as is
+				return m_file.read_at(start, out, size) == size;
+			}
+
+			thread_local std::vector<u8> compressed;
+			thread_local std::unique_ptr<ZSTD_DCtx, zstd_dctx_deleter> dctx{ZSTD_createDCtx()};
+
+			compressed.resize(end - start);
+
+			if (m_file.read_at(start, compressed.data(), compressed.size()) != compressed.size())
+			{
+				sys_log.error("Compressed ISO: failed to read block 0x%x", index);
+				return false;
+			}
+
+			const usz result = ZSTD_decompressDCtx(dctx.get(), out, size, compressed.data(), compressed.size());
+
+			if (ZSTD_isError(result) || result != size)
+			{
+				sys_log.error("Compressed ISO: failed to decompress block 0x%x (%s)", index, ZSTD_isError(result) ? ZSTD_getErrorName(result) : "size mismatch");
+				return false;
+			}
+
+			return true;
+		}
+
+		bool read_cached(u64 index, u64 block_offset, u8* out, u64 count)
+		{
+			{
+				reader_lock lock(m_mutex);
+
+				for (const auto& [cached_index, data] : m_cache)
+				{
+					if (cached_index == index && !data.empty())
+					{
+						std::memcpy(out, data.data() + block_offset, count);
+						return true;
+					}
+				}
+			}
+
+			std::vector<u8> data(block_size(index));
+
+			if (!decompress_block(index, data.data()))
+			{
+				return false;
+			}
+
+			std::memcpy(out, data.data() + block_offset, count);
+
+			std::lock_guard lock(m_mutex);
+			m_cache[m_cache_next++ % c_cached_blocks] = {index, std::move(data)};
+			return true;
+		}
+
+	public:
+		compressed_iso_file(fs::file&& file, const compressed_iso_header& header)
+			: m_file(std::move(file))
+			, m_header(header)
+		{
+		}
+
+		fs::stat_t get_stat() override
+		{
+			fs::stat_t stat = m_file.get_stat();
+			stat.size = m_header.image_size;
+			return stat;
+		}
+
+		bool trunc(u64) override
+		{
+			fs::g_tls_error = fs::error::readonly;
+			return false;
+		}
+
+		u64 read(void* buffer, u64 size) override
+		{
+			const u64 result = read_at(m_pos, buffer, size);
+			m_pos += result;
+			return result;
+		}
+
+		u64 read_at(u64 offset, void* buffer, u64 size) override
+		{
+			if (offset >= m_header.image_size || !size)
+			{
+				return 0;
+			}
+
+			size = std::min<u64>(size, m_header.image_size - offset);
+
+			const u64 bs = m_header.block_size;
+			const u64 end = offset + size;
+			const u64 first = offset / bs;
+			const u64 last = (end - 1) / bs;
+			u8* const out = static_cast<u8*>(buffer);
+
+			// Blocks entirely covered by the request are decompressed directly into the buffer
+			const u64 inner_first = offset % bs ? first + 1 : first;
+			const u64 inner_end = end == std::min<u64>((last + 1) * bs, m_header.image_size) ? last + 1 : last;
+
+			if (inner_first > inner_end)
+			{
+				// The request is inside a single block
+				return read_cached(first, offset % bs, out, size) ? size : 0;
+			}
+
+			// The first block may also be the short final block of the image
+			if (inner_first > first && !read_cached(first, offset % bs, out, std::min<u64>(size, block_size(first) - offset % bs)))
+			{
+				return 0;
+			}
+
+			if (inner_end == last && !read_cached(last, 0, out + (last * bs - offset), end - last * bs))
+			{
+				return 0;
+			}
+
+			if (inner_first >= inner_end)
+			{
+				return size;
+			}
+
+			atomic_t<u64> next = inner_first;
+			atomic_t<bool> failed = false;
+
+			const auto worker = [&]()
+			{
+				for (u64 i = next.fetch_add(1); i < inner_end && !failed; i = next.fetch_add(1))
+				{
+					if (!decompress_block(i, out + (i * bs - offset)))
+					{
+						failed = true;
+					}
+				}
+			};
+
+			if (inner_end - inner_first >= c_parallel_min_blocks)
+			{
+				const u32 thread_count = std::min<u32>(utils::get_thread_count(), ::narrow<u32>((inner_end - inner_first) / (c_parallel_min_blocks / 4)));
+
+				named_thread_group workers("CISO Decompressor "sv, thread_count - 1, [&]()
+				{
+					worker();
+				});
+
+				worker();
+				workers.join();
+			}
+			else
+			{
+				worker();
+			}
+
+			return failed ? 0 : size;
+		}
+
+		u64 write(const void*, u64) override
+		{
+			fs::g_tls_error = fs::error::readonly;
+			return 0;
+		}
+
+		u64 seek(s64 offset, fs::seek_mode whence) override
+		{
+			const s64 new_pos =
+				whence == fs::seek_set ? offset :
+				whence == fs::seek_cur ? offset + m_pos :
+				whence == fs::seek_end ? offset + size() : -1;
+
+			if (new_pos < 0)
+			{
+				fs::g_tls_error = fs::error::inval;
+				return -1;
+			}
+
+			m_pos = new_pos;
+			return m_pos;
+		}
+
+		u64 size() override
+		{
+			return m_header.image_size;
+		}
+
+		fs::file_id get_id() override
+		{
+			fs::file_id id = m_file.get_id();
+
+			id.type.insert(0, "compressed_iso_file: "sv);
+			return id;
+		}
+	};
+}
+
+bool is_file_compressed_iso(const fs::file& file)
+{
+	compressed_iso_header header{};
+
+	return file && file.read_at(0, &header, sizeof(header)) == sizeof(header) && check_header(header, file.size());
+}
+
+fs::file open_iso_image(const std::string& path, bs_t<fs::open_mode> mode)
+{
+	fs::file file(path, mode);
+	compressed_iso_header header{};
+
+	if (file && file.read_at(0, &header, sizeof(header)) == sizeof(header) && check_header(header, file.size()))
+	{
+		return fs::file(std::make_unique<compressed_iso_file>(std::move(file), header));
+	}
+
+	return file;
+}
+
+bool compress_iso(const std::string& iso_path, const std::string& out_path, const std::function<void(u64 done, u64 total)>& progress)
+{
+	const fs::file in(iso_path);
+
+	if (!in)
+	{
+		sys_log.error("compress_iso(): Failed to open '%s' (error=%s)", iso_path, fs::g_tls_error);
+		return false;
+	}
+
+	if (is_file_compressed_iso(in))
+	{
+		sys_log.error("compress_iso(): '%s' is already compressed", iso_path);
+		return false;
+	}
+
+	// Only replace the destination once the whole image has been written
+	fs::pending_file out(out_path);
+
+	if (!out.file)
+	{
+		sys_log.error("compress_iso(): Failed to create '%s' (error=%s)", out_path, fs::g_tls_error);
+		return false;
+	}
+
+	const auto write_out = [&](const void* data, u64 size)
+	{
+		if (out.file.write(data, size) != size)
+		{
+			sys_log.error("compress_iso(): Failed to write '%s' (error=%s)", out_path, fs::g_tls_error);
+			return false;
+		}
+
+		return true;
+	};
+
+	const u64 image_size = in.size();
+	const u64 block_count = utils::aligned_div<u64>(image_size, c_block_size);
+
+	compressed_iso_header header{};
+	std::memcpy(header.magic, "RCSO", 4);
+	header.version = c_version;
+	header.image_size = image_size;
+	header.block_size = c_block_size;
+	header.index_offset = sizeof(compressed_iso_header);
+
+	// The index is written again once all the block offsets are known
+	std::vector<le_t<u64>> index(block_count + 1);
+
+	if (!write_out(&header, sizeof(header)) || !write_out(index.data(), index.size() * sizeof(u64)))
+	{
+		return false;
+	}
+
+	u64 pos = header.index_offset + index.size() * sizeof(u64);
+
+	const u32 thread_count = utils::get_thread_count();
+	const u64 batch_blocks = thread_count * u64{16};
+
+	std::vector<u8> input(batch_blocks * c_block_size);
+	std::vector<std::vector<u8>> output(batch_blocks);
+
+	for (u64 first = 0; first < block_count; first += batch_blocks)
+	{
+		const u64 count = std::min<u64>(batch_blocks, block_count - first);
+		const u64 read_size = std::min<u64>(count * c_block_size, image_size - first * c_block_size);
+
+		if (in.read_at(first * c_block_size, input.data(), read_size) != read_size)
+		{
+			sys_log.error("compress_iso(): Failed to read '%s' at 0x%x", iso_path, first * c_block_size);
+			return false;
+		}
+
+		atomic_t<u64> next = 0;
+
+		const auto worker = [&]()
+		{
+			thread_local std::unique_ptr<ZSTD_CCtx, zstd_cctx_deleter> cctx{ZSTD_createCCtx()};
+
+			for (u64 i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+			{
+				const u64 size = std::min<u64>(c_block_size, read_size - i * c_block_size);
+				const u8* src = input.data() + i * c_block_size;
+				std::vector<u8>& dst = output[i];
+
+				dst.resize(ZSTD_compressBound(size));
+
+				const usz result = ZSTD_compressCCtx(cctx.get(), dst.data(), dst.size(), src, size, c_compression_level);
+
+				if (ZSTD_isError(result) || result >= size)
+				{
+					// Store as is
+					dst.assign(src, src + size);
+					continue;
+				}
+
+				dst.resize(result);
+			}
+		};
+
+		named_thread_group workers("CISO Compressor "sv, thread_count - 1, [&]()
+		{
+			worker();
+		});
+
+		worker();
+		workers.join();
+
+		for (u64 i = 0; i < count; i++)
+		{
+			index[first + i] = pos;
+
+			if (!write_out(output[i].data(), output[i].size()))
+			{
+				return false;
+			}
+
+			pos += output[i].size();
+		}
+
+		if (progress)
+		{
+			progress(first + count, block_count);
+		}
+	}
+
+	index[block_count] = pos;
+
+	out.file.seek(header.index_offset);
+
+	if (!write_out(index.data(), index.size() * sizeof(u64)))
+	{
+		return false;
+	}
+
+	if (!out.commit())
+	{
+		sys_log.error("compress_iso(): Failed to commit '%s' (error=%s)", out_path, fs::g_tls_error);
+		return false;
+	}
+
+	sys_log.success("Compressed ISO '%s' to '%s' (0x%x -> 0x%x bytes)", iso_path, out_path, image_size, pos);
+	return true;
+}
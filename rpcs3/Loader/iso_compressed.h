@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Utilities/File.h"
+#include "util/endian.hpp"
+#include "util/types.hpp"
+
+#include <functional>
+
+/*
+- Block-compressed ISO image (.ciso): the raw image is split into fixed-size blocks which are compressed
+  independently with zstd, so any block can be decompressed on its own (random access).
+
+- Layout:
+  - compressed_iso_header
+  - Block index: (block_count + 1) little-endian u64 file offsets, block i is stored in [index[i], index[i + 1])
+  - Block data: a block which doesn't compress is stored as is (stored size == uncompressed block size)
+
+- Encrypted images stay encrypted inside the container, the Redump key file is looked up next to the .ciso file
+*/
+
+struct compressed_iso_header
+{
+	char magic[4];          // "RCSO"
+	le_t<u32> version;      // 1
+	le_t<u64> image_size;   // Size of the uncompressed image
+	le_t<u32> block_size;   // Size of the uncompressed blocks (multiple of the ISO sector size)
+	le_t<u32> index_offset; // Offset of the block index
+	le_t<u64> reserved;
+};
+
+static_assert(sizeof(compressed_iso_header) == 32);
+
+// Check the header of a compressed ISO image
+bool is_file_compressed_iso(const fs::file& file);
+
+// Open an ISO image for reading, block-compressed images are decompressed transparently
+fs::file open_iso_image(const std::string& path, bs_t<fs::open_mode> mode = fs::read);
+
+// Convert a raw ISO image to a block-compressed image
+bool compress_iso(const std::string& iso_path, const std::string& out_path, const std::function<void(u64 done, u64 total)>& progress = {});
@@ -5,6 +5,7 @@
 #include <chrono>
 #include <clocale>
 #include <span>
+#include <filesystem>
 
 #include <QApplication>
 #include <QCommandLineParser>
@@ -28,6 +29,7 @@
 #include "util/console.h"
 #include "util/asm.hpp"
 #include "Crypto/decrypt_binaries.h"
+#include "Emu/cache_builder.hpp"
 #ifdef _WIN32
 #include "module_verifier.hpp"
 #include "util/dyn_lib.hpp"
@@ -70,6 +72,7 @@ DYNAMIC_IMPORT("ntdll.dll", NtSetTimerResolution, NTSTATUS(ULONG DesiredResoluti
 #include "Emu/System.h"
 #include "Emu/system_config.h"
 #include "Emu/system_utils.hpp"
+#include "Loader/iso_compressed.h"
 #include "Emu/RSX/Overlays/overlay_message.h"
 #include <thread>
 #include <charconv>
@@ -386,6 +389,9 @@ private:
 // Arguments that force a headless application (need to be checked in create_application)
 constexpr auto arg_headless     = "headless";
 constexpr auto arg_decrypt      = "decrypt";
+constexpr auto arg_installpkg_stream = "installpkg-stream";
+constexpr auto arg_compress_iso = "compress-iso";
+constexpr auto arg_build_caches = "build-caches";
 
 // Arguments that can be used with a gui application
 constexpr auto arg_no_gui       = "no-gui";
@@ -404,6 +410,7 @@ constexpr auto arg_updating     = "updating";
 constexpr auto arg_user_id      = "user-id";
 constexpr auto arg_installfw    = "installfw";
 constexpr auto arg_installpkg   = "installpkg";
+constexpr auto arg_stream_timeout = "stream-timeout"; // only useful with installpkg-stream
 constexpr auto arg_savestate    = "savestate";
 constexpr auto arg_rsx_capture  = "rsx-capture";
 constexpr auto arg_timer        = "high-res-timer";
@@ -440,7 +447,10 @@ QCoreApplication* create_application(std::span<char* const> qt_argv)
 	static char** const s_argv = const_cast<char**>(qt_argv.data());
 
 	if (find_arg(arg_headless, qt_argv) != -1 ||
-		find_arg(arg_decrypt, qt_argv) != -1)
+		find_arg(arg_decrypt, qt_argv) != -1 ||
+		find_arg(arg_installpkg_stream, qt_argv) != -1 ||
+		find_arg(arg_compress_iso, qt_argv) != -1 ||
+		find_arg(arg_build_caches, qt_argv) != -1)
 	{
 		return new headless_application(s_argc, s_argv);
 	}
@@ -829,6 +839,15 @@ int run_rpcs3(int argc, char** argv)
 	parser.addOption(installfw_option);
 	const QCommandLineOption installpkg_option(arg_installpkg, "Forces the emulator to install this pkg file.", "path", "");
 	parser.addOption(installpkg_option);
+	const QCommandLineOption installpkg_stream_option(arg_installpkg_stream, "Install a pkg file while it is being received from a pipe, FIFO or growing file (\"-\" for stdin). "
+		"PARAM.SFO must be within the first 1 GiB of the package, otherwise version checks are skipped.", "path", "");
+	parser.addOption(installpkg_stream_option);
+	const QCommandLineOption stream_timeout_option(arg_stream_timeout, "Seconds without new data before a streamed pkg installation fails (default: 10, 0: wait until the whole package is received).", "seconds", "10");
+	parser.addOption(stream_timeout_option);
+	const QCommandLineOption compress_iso_option(arg_compress_iso, "Convert an ISO image to a block-compressed image (.ciso) next to it.", "path", "");
+	parser.addOption(compress_iso_option);
+	const QCommandLineOption build_caches_option(arg_build_caches, "Create PPU and SPU caches of the titles in this directory or its subdirectories. Finished titles are skipped on the next run.", "path(s)", "");
+	parser.addOption(build_caches_option);
 	const QCommandLineOption decrypt_option(arg_decrypt, "Decrypt PS3 binaries.", "path(s)", "");
 	parser.addOption(decrypt_option);
 	const QCommandLineOption user_id_option(arg_user_id, "Start RPCS3 as this user.", "user id", "");
@@ -1141,6 +1160,66 @@ int run_rpcs3(int argc, char** argv)
 		return 0;
 	}
 
+	if (parser.isSet(arg_installpkg_stream))
+	{
+		bool ok = false;
+		const u32 timeout = parser.value(stream_timeout_option).toUInt(&ok);
+
+		if (!ok)
+		{
+			report_fatal_error(fmt::format("The option '%s' can only be used with numbers >= 0 (you used %s)", arg_stream_timeout, parser.value(stream_timeout_option).toStdString()));
+		}
+
+		Emu.Init();
+
+		const bool success = rpcs3::utils::install_pkg(parser.value(installpkg_stream_option).toStdString(), true, timeout);
+
+		Emu.Quit(true);
+		return success ? 0 : 1;
+	}
+
+	if (parser.isSet(arg_compress_iso))
+	{
+		const std::string iso_path = parser.value(compress_iso_option).toStdString();
+		const std::string out_path = std::filesystem::path(iso_path).replace_extension(".ciso").string();
+
+		const bool success = compress_iso(iso_path, out_path, [](u64 done, u64 total)
+		{
+			sys_log.notice("Compressing ISO: %u/%u blocks", done, total);
+		});
+
+		return success ? 0 : 1;
+	}
+
+	if (parser.isSet(arg_build_caches))
+	{
+		std::vector<std::string> dirs;
+
+		for (const QString& dir : parser.values(build_caches_option))
+		{
+			dirs.push_back(QFileInfo(dir).absoluteFilePath().toStdString());
+		}
+
+		Emu.Init();
+
+		const auto builder = std::make_shared<cache_builder>(dirs, fs::get_cache_dir() + "cache_builder.txt");
+
+		// Titles are booted from the main event loop, one after another
+		QTimer* timer = new QTimer(app.data());
+		QObject::connect(timer, &QTimer::timeout, [builder, timer]()
+		{
+			if (!builder->step())
+			{
+				timer->stop();
+				sys_log.success("Cache builder: Done (%u title(s), %u failed)", builder->size(), builder->failed());
+				Emu.Quit(true);
+			}
+		});
+		timer->start(100);
+
+		return app->exec();
+	}
+
 	// Force install firmware or pkg first if specified through command-line
 	if (parser.isSet(arg_installfw) || parser.isSet(arg_installpkg))
 	{
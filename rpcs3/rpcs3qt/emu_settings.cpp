@@ -1367,6 +1367,13 @@ QString emu_settings::GetLocalizedSetting(const QString& original, emu_settings_
 		case audio_channel_layout::surround_7_1:     return tr("Surround 7.1", "Audio Channel Layout");
 		}
 		break;
+	case emu_settings_type::TimeStretchingResampler:
+		switch (static_cast<audio_resampler_type>(index))
+		{
+		case audio_resampler_type::soundtouch: return tr("SoundTouch", "Time Stretching Resampler");
+		case audio_resampler_type::sinc:       return tr("Windowed Sinc", "Time Stretching Resampler");
+		}
+		break;
 	case emu_settings_type::LicenseArea:
 		switch (static_cast<CellSysutilLicenseArea>(index))
 		{
@@ -149,6 +149,7 @@ enum class emu_settings_type
 	AudioBufferDuration,
 	EnableTimeStretching,
 	TimeStretchingThreshold,
+	TimeStretchingResampler,
 	MicrophoneType,
 	MicrophoneDevices,
 	MusicHandler,
@@ -367,6 +368,7 @@ inline static const std::map<emu_settings_type, cfg_location> settings_location
 	{ emu_settings_type::AudioBufferDuration,     { "Audio", "Desired Audio Buffer Duration"}},
 	{ emu_settings_type::EnableTimeStretching,    { "Audio", "Enable Time Stretching"}},
 	{ emu_settings_type::TimeStretchingThreshold, { "Audio", "Time Stretching Threshold"}},
+	{ emu_settings_type::TimeStretchingResampler, { "Audio", "Time Stretching Resampler"}},
 	{ emu_settings_type::MicrophoneType,          { "Audio", "Microphone Type" }},
 	{ emu_settings_type::MicrophoneDevices,       { "Audio", "Microphone Devices" }},
 	{ emu_settings_type::MusicHandler,            { "Audio", "Music Handler"}},
@@ -16,7 +16,7 @@
 #include "Emu/system_utils.hpp"
 #include "Loader/PSF.h"
 #include "Loader/ISO.h"
-#include "Loader/iso_cache.h"
+#include "Loader/game_index.h"
 #include "util/types.hpp"
 #include "Utilities/File.h"
 #include "util/sysinfo.hpp"
@@ -31,6 +31,8 @@
 #include <QMessageBox>
 #include <QScrollBar>
 #include <QApplication>
+#include <QFileSystemWatcher>
+#include <QTimer>
 
 LOG_CHANNEL(game_list_log, "GameList");
 LOG_CHANNEL(sys_log, "SYS");
@@ -130,6 +132,29 @@ game_list_frame::game_list_frame(std::shared_ptr<gui_settings> gui_settings, std
 		m_notes.clear();
 		m_games.pop_all();
 	});
+
+	// Refresh the game list when games are added to or removed from the scanned directories (inotify on Linux)
+	m_dir_watcher = new QFileSystemWatcher(this);
+	m_dir_watcher_timer = new QTimer(this);
+	m_dir_watcher_timer->setSingleShot(true);
+	m_dir_watcher_timer->setInterval(2000); // Let copies and installations settle first
+
+	connect(m_dir_watcher, &QFileSystemWatcher::directoryChanged, m_dir_watcher_timer, qOverload<>(&QTimer::start));
+	connect(m_dir_watcher_timer, &QTimer::timeout, this, [this]()
+	{
+		if (!Emu.IsStopped(true) || m_parsing_watcher.isRunning() || m_refresh_watcher.isRunning())
+		{
+			// Try again later
+			m_dir_watcher_timer->start();
+			return;
+		}
+
+		game_list_log.notice("Game directory changed, refreshing the game list");
+
+		// Unchanged games are served from the game index
+		Refresh(true, {}, false);
+	});
+
 	connect(&m_parsing_watcher, &QFutureWatcher<void>::finished, this, &game_list_frame::OnParsingFinished);
 	connect(&m_parsing_watcher, &QFutureWatcher<void>::canceled, this, [this]()
 	{
@@ -388,6 +413,19 @@ void game_list_frame::Refresh(const bool from_drive, const std::vector<std::stri
 
 		const std::string _hdd = Emu.GetCallbacks().resolve_path(rpcs3::utils::get_hdd0_dir()) + '/';
 
+		if (const QStringList watched_dirs = m_dir_watcher->directories(); !watched_dirs.isEmpty())
+		{
+			m_dir_watcher->removePaths(watched_dirs);
+		}
+
+		for (const std::string& dir : {_hdd + "game/", games_dir})
+		{
+			if (fs::is_dir(dir))
+			{
+				m_dir_watcher->addPath(QString::fromStdString(dir));
+			}
+		}
+
 		m_parsing_watcher.setFuture(QtConcurrent::map(m_parsing_threads, [this, _hdd](int index)
 		{
 			if (index > 0)
@@ -531,63 +569,69 @@ void game_list_frame::OnParsingFinished()
 	                       (const std::string& dir_or_elf)
 	{
 		std::unique_ptr<iso_archive> archive;
-		iso_metadata_cache_entry cache_entry{};
+		game_index_entry cache_entry{};
 		const bool is_iso = is_file_iso(dir_or_elf);
-		
-		if (is_iso)
+
+		const std::string sfo_dir = is_iso ? "PS3_GAME" : rpcs3::utils::get_sfo_dir_from_game_path(dir_or_elf);
+		const std::string sfo_path = sfo_dir + "/PARAM.SFO";
+
+		// ISOs are indexed by their own path, folder games by their PARAM.SFO
+		const std::string index_path = is_iso ? dir_or_elf : sfo_path;
+
+		// Only parse PARAM.SFO and construct iso_archive (which walks the full directory tree)
+		// when no valid index entry exists for this game. Media paths are always resolved below,
+		// since they depend on the current language and settings.
+		bool cache_hit = game_index::load(index_path, cache_entry) && (!is_iso || cache_entry.has_media);
+
 		{
-			// Only construct iso_archive (which walks the full directory tree)
-			// when no valid cache entry exists for this ISO path + mtime.
-			if (!iso_cache::load(dir_or_elf, cache_entry))
-			{
-				archive = std::make_unique<iso_archive>(dir_or_elf);
-			}
-			// Track this ISO path for cache cleanup after scan completes.
+			// Track this path for index cleanup after scan completes.
 			std::lock_guard lock(m_path_mutex);
-			m_scanned_iso_paths.insert(dir_or_elf);
+			m_scanned_index_paths.insert(index_path);
 		}
 
-		const auto file_exists = [&archive, &cache_entry](const std::string& path)
-		{
-			if (archive) return archive->is_file(path);
-			// On cache hit, paths inside the ISO are not accessible via fs::is_file.
-			// Return false here — cache hit paths are handled separately.
-			if (!cache_entry.psf_data.empty()) return false;
-			return fs::is_file(path);
-		};
-
 		gui_game_info game{};
 		game.info.path = dir_or_elf;
 
 		const Localized thread_localized;
 
-		const std::string sfo_dir = (archive || !cache_entry.psf_data.empty()) ? "PS3_GAME" : rpcs3::utils::get_sfo_dir_from_game_path(dir_or_elf);
-		const std::string sfo_path = sfo_dir + "/PARAM.SFO";
-
-		// Load PSF: from archive on cache miss, rehydrate from cached SFO bytes on hit.
+		// Load PSF: rehydrate from cached SFO bytes on hit.
 		psf::registry psf{};
-		if (archive)
-		{
-			psf = archive->open_psf(sfo_path);
-		}
-		else if (!cache_entry.psf_data.empty())
+		if (cache_hit)
 		{
 			psf = psf::load_object(fs::make_stream<std::vector<u8>>(std::vector<u8>(cache_entry.psf_data)), sfo_path);
-			// Fallback to archive scan if cached PSF is corrupted or missing critical fields.
-			const bool psf_valid = !psf::get_string(psf, "TITLE_ID", "").empty()
+			// Fallback to a full scan if cached PSF is corrupted or missing critical fields.
+			cache_hit = !psf::get_string(psf, "TITLE_ID", "").empty()
 				&& !psf::get_string(psf, "TITLE", "").empty()
 				&& !psf::get_string(psf, "CATEGORY", "").empty();
-			if (!psf_valid)
+		}
+
+		if (!cache_hit)
+		{
+			cache_entry = {}; // Reset so the entry gets rewritten after scan.
+
+			if (is_iso)
 			{
 				archive = std::make_unique<iso_archive>(dir_or_elf);
 				psf = archive->open_psf(sfo_path);
-				cache_entry = {}; // Reset so the cache gets rewritten after scan.
+			}
+			else
+			{
+				psf = psf::load_object(sfo_path);
 			}
 		}
-		else
+
+		const auto file_exists = [&archive, &sfo_dir, &cache_entry, is_iso, cache_hit](const std::string& path)
 		{
-			psf = psf::load_object(sfo_path);
-		}
+			if (archive) return archive->is_file(path);
+			// On cache hit, the media files inside an ISO are listed in the index
+			// (paths inside an ISO are not accessible via fs::is_file).
+			if (is_iso && cache_hit && path.starts_with(sfo_dir))
+			{
+				const auto& files = cache_entry.media_files;
+				return std::find(files.begin(), files.end(), path) != files.end();
+			}
+			return fs::is_file(path);
+		};
 
 		const std::string_view title_id = psf::get_string(psf, "TITLE_ID", "");
 
@@ -656,32 +700,20 @@ void game_list_frame::OnParsingFinished()
 
 		if (game.info.icon_path.empty())
 		{
-			if (!cache_entry.icon_path.empty())
-			{
-				// Cache hit — icon path already resolved on a previous scan.
-				game.info.icon_path = cache_entry.icon_path;
-				game.icon_in_archive = true;
-			}
-			else if (std::string icon_path = sfo_dir + "/" + localized_icon; file_exists(icon_path))
+			if (std::string icon_path = sfo_dir + "/" + localized_icon; file_exists(icon_path))
 			{
 				game.info.icon_path = std::move(icon_path);
-				game.icon_in_archive = archive && archive->exists(game.info.icon_path);
 			}
 			else
 			{
 				game.info.icon_path = sfo_dir + "/ICON0.PNG";
-				game.icon_in_archive = archive && archive->exists(game.info.icon_path);
 			}
+
+			game.icon_in_archive = is_iso && file_exists(game.info.icon_path);
 		}
 
 		if (play_hover_movies)
 		{
-			if (!cache_entry.movie_path.empty() && !archive)
-			{
-				// Cache hit — restore previously resolved movie path.
-				game.info.movie_path = cache_entry.movie_path;
-				game.has_hover_pam = true;
-			}
 			if (std::string movie_path = game_icon_path + game.info.serial + "/hover.gif"; file_exists(movie_path))
 			{
 				game.info.movie_path = std::move(movie_path);
@@ -701,12 +733,6 @@ void game_list_frame::OnParsingFinished()
 
 		if (play_hover_music)
 		{
-			if(!cache_entry.audio_path.empty() && !archive)
-			{
-				// Cache hit — restore previously resolved audio path.
-				game.info.audio_path = cache_entry.audio_path;
-				game.has_audio_file = true;
-			}
 			if (std::string audio_path = sfo_dir + "/SND0.AT3"; file_exists(audio_path))
 			{
 				game.info.audio_path = std::move(audio_path);
@@ -714,33 +740,45 @@ void game_list_frame::OnParsingFinished()
 			}
 		}
 
-		// On cache miss for an ISO, persist the resolved metadata so subsequent
-		// launches skip iso_archive construction entirely.
-		if (archive && is_iso)
+		// On cache miss, persist PARAM.SFO so subsequent refreshes skip parsing it.
+		// For ISOs, also list the media files so iso_archive doesn't need to be constructed.
+		if (!cache_hit && !psf.empty())
 		{
-			fs::stat_t iso_stat{};
-			if (fs::get_stat(dir_or_elf, iso_stat))
+			cache_entry.psf_data = psf::save_object(psf);
+
+			if (archive)
 			{
-				cache_entry.mtime      = iso_stat.mtime;
-				cache_entry.psf_data   = psf::save_object(psf);
-				cache_entry.icon_path  = game.info.icon_path;
-				cache_entry.movie_path = game.info.movie_path;
-				cache_entry.audio_path = game.info.audio_path;
-
-				// Cache raw icon bytes so load_iso_icon can skip archive open.
-				if (game.icon_in_archive)
+				cache_entry.has_media = true;
+
+				if (const iso_fs_node* node = archive->retrieve(sfo_dir))
 				{
-					auto icon_file = archive->open(game.info.icon_path);
-					const auto icon_size = icon_file.size();
-					if (icon_size > 0)
+					for (const auto& child : node->children)
 					{
-						cache_entry.icon_data.resize(icon_size);
-						icon_file.read(cache_entry.icon_data.data(), icon_size);
+						const std::string& name = child->metadata.name;
+
+						if (!child->metadata.is_directory && (name.starts_with("ICON") || name == "SND0.AT3"))
+						{
+							cache_entry.media_files.emplace_back(sfo_dir + "/" + name);
+						}
 					}
 				}
+			}
+
+			// Cache raw icon bytes so load_iso_icon can skip archive open.
+			if (archive && game.icon_in_archive)
+			{
+				cache_entry.icon_path = game.info.icon_path;
 
-				iso_cache::save(dir_or_elf, cache_entry);
+				auto icon_file = archive->open(game.info.icon_path);
+				const auto icon_size = icon_file.size();
+				if (icon_size > 0)
+				{
+					cache_entry.icon_data.resize(icon_size);
+					icon_file.read(cache_entry.icon_data.data(), icon_size);
+				}
 			}
+
+			game_index::save(index_path, std::move(cache_entry));
 		}
 
 		const QString serial = QString::fromStdString(game.info.serial);
@@ -905,8 +943,9 @@ void game_list_frame::OnRefreshFinished()
 	WaitAndAbortSizeCalcThreads();
 	WaitAndAbortRepaintThreads();
 
-	// Remove cache entries for ISOs that are no longer present in the scanned paths.
-	iso_cache::cleanup(m_scanned_iso_paths);
+	// Remove index entries for games that are no longer present in the scanned paths.
+	game_index::cleanup(m_scanned_index_paths);
+	game_index::flush();
 
 	for (auto&& g : m_games.pop_all())
 	{
@@ -994,7 +1033,7 @@ void game_list_frame::OnRefreshFinished()
 	m_serials.clear();
 	m_path_list.clear();
 	m_path_entries.clear();
-	m_scanned_iso_paths.clear();
+	m_scanned_index_paths.clear();
 
 	Refresh();
 
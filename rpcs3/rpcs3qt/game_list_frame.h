@@ -24,6 +24,8 @@ class gui_settings;
 class emu_settings;
 class persistent_settings;
 class progress_dialog;
+class QFileSystemWatcher;
+class QTimer;
 
 class game_list_frame : public custom_dock_widget
 {
@@ -181,13 +183,15 @@ private:
 	std::vector<path_entry> m_path_entries;
 	shared_mutex m_path_mutex;
 	std::set<std::string> m_path_list;
-	std::unordered_set<std::string> m_scanned_iso_paths;
+	std::unordered_set<std::string> m_scanned_index_paths;
 	QSet<QString> m_serials;
 	QMutex m_games_mutex;
 	lf_queue<game_info> m_games;
 	const std::array<int, 1> m_parsing_threads{0};
 	QFutureWatcher<void> m_parsing_watcher;
 	QFutureWatcher<void> m_refresh_watcher;
+	QFileSystemWatcher* m_dir_watcher = nullptr;
+	QTimer* m_dir_watcher_timer = nullptr;
 	QSet<QString> m_hidden_list;
 	bool m_show_hidden{false};
 
@@ -13,7 +13,7 @@
 #include "Emu/system_utils.hpp"
 #include "Utilities/File.h"
 #include "Loader/ISO.h"
-#include "Loader/iso_cache.h"
+#include "Loader/game_index.h"
 #include <cmath>
 
 LOG_CHANNEL(gui_log, "GUI");
@@ -711,11 +711,10 @@ namespace gui
 			if (!is_file_iso(archive_path)) return false;
 
 			// Check cache first — avoids constructing a full iso_archive just for the icon.
-			iso_metadata_cache_entry cache_entry{};
-			if (iso_cache::load(archive_path, cache_entry) && !cache_entry.icon_data.empty())
+			if (std::vector<u8> icon_data; game_index::load_icon(archive_path, icon_path, icon_data))
 			{
-				const QByteArray data(reinterpret_cast<const char*>(cache_entry.icon_data.data()),
-				                      static_cast<qsizetype>(cache_entry.icon_data.size()));
+				const QByteArray data(reinterpret_cast<const char*>(icon_data.data()),
+				                      static_cast<qsizetype>(icon_data.size()));
 				return icon.loadFromData(data);
 			}
 
@@ -1128,6 +1128,9 @@ settings_dialog::settings_dialog(std::shared_ptr<gui_settings> gui_settings, std
 	m_emu_settings->EnhanceCheckBox(ui->enableTimeStretching, emu_settings_type::EnableTimeStretching);
 	SubscribeTooltip(ui->enableTimeStretching, tooltips.settings.enable_time_stretching);
 
+	m_emu_settings->EnhanceComboBox(ui->timeStretchingResamplerBox, emu_settings_type::TimeStretchingResampler);
+	SubscribeTooltip(ui->time_stretching_resampler, tooltips.settings.time_stretching_resampler);
+
 	// Sliders
 
 	EnhanceSlider(emu_settings_type::MasterVolume, ui->masterVolume, ui->masterVolumeLabel, tr("Master: %0 %", "Master volume"));
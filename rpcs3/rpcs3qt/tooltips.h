@@ -77,6 +77,7 @@ public:
 		const QString audio_buffer_duration     = tr("Target buffer duration in milliseconds.\nHigher values make the buffering algorithm's job easier, but may introduce noticeable audio latency.");
 		const QString enable_time_stretching    = tr("Enables time stretching - requires buffering to be enabled.\nReduces crackle/stutter further, but may cause a very noticeable reduction in audio quality on slower CPUs.");
 		const QString time_stretching_threshold = tr("Buffer fill level (in percentage) below which time stretching will start.");
+		const QString time_stretching_resampler = tr("SoundTouch keeps the pitch of stretched audio, but needs a lot of CPU time and adds latency.\nWindowed Sinc is much cheaper and has almost no latency, but stretched audio sounds lower pitched.\nUse Windowed Sinc on slower CPUs.");
 		const QString microphone                = tr("Standard should be used for most games.\nSingStar emulates a SingStar device and should be used with SingStar games.\nReal SingStar should only be used with a REAL SingStar device with SingStar games.\nRocksmith should be used with a Rocksmith dongle.");
 
 		// cpu
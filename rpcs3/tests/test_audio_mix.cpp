@@ -0,0 +1,120 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "Emu/Audio/audio_mix.h"
+
+#include <chrono>
+#include <random>
+
+namespace audio
+{
+	template <AudioChannelCnt channels, AudioChannelCnt downmix, u32 in_channels>
+	struct mix_config
+	{
+		static constexpr u32 out_channels = static_cast<u32>(channels);
+
+		std::vector<be_t<f32>> input = std::vector<be_t<f32>>(in_channels * AUDIO_BUFFER_SAMPLES);
+		std::vector<f32> volume = std::vector<f32>(AUDIO_BUFFER_SAMPLES);
+		std::vector<f32> expected = std::vector<f32>(out_channels * AUDIO_BUFFER_SAMPLES);
+		std::vector<f32> result = std::vector<f32>(out_channels * AUDIO_BUFFER_SAMPLES);
+
+		mix_config()
+		{
+			std::mt19937 rng(in_channels * 100 + out_channels * 10 + static_cast<u32>(downmix));
+			std::uniform_real_distribution<f32> dist(-1.0f, 1.0f);
+
+			for (auto& sample : input) sample = dist(rng);
+			for (auto& sample : expected) sample = dist(rng);
+
+			// Volume ramp
+			for (u32 i = 0; i < AUDIO_BUFFER_SAMPLES; i++) volume[i] = 1.0f - i / 512.0f;
+		}
+
+		template <bool ramp>
+		void check()
+		{
+			result = expected;
+
+			mix_port_scalar<channels, downmix, in_channels, ramp>(expected.data(), input.data(), volume.data(), 0, AUDIO_BUFFER_SAMPLES);
+			mix_port<channels, downmix, in_channels, ramp>(result.data(), input.data(), volume.data(), AUDIO_BUFFER_SAMPLES);
+
+			for (usz i = 0; i < result.size(); i++)
+			{
+				ASSERT_NEAR(result[i], expected[i], 1e-5f) << "channels=" << out_channels << " downmix=" << static_cast<u32>(downmix) << " in_channels=" << in_channels << " ramp=" << ramp << " index=" << i;
+			}
+		}
+
+		template <bool simd>
+		f64 benchmark()
+		{
+			constexpr u32 iterations = 20000;
+
+			const auto start = std::chrono::steady_clock::now();
+
+			for (u32 i = 0; i < iterations; i++)
+			{
+				if constexpr (simd)
+					mix_port<channels, downmix, in_channels, false>(result.data(), input.data(), volume.data(), AUDIO_BUFFER_SAMPLES);
+				else
+					mix_port_scalar<channels, downmix, in_channels, false>(result.data(), input.data(), volume.data(), 0, AUDIO_BUFFER_SAMPLES);
+			}
+
+			return std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / iterations;
+		}
+	};
+
+	template <AudioChannelCnt channels, AudioChannelCnt downmix>
+	void check_all()
+	{
+		mix_config<channels, downmix, 2>().template check<false>();
+		mix_config<channels, downmix, 2>().template check<true>();
+		mix_config<channels, downmix, 8>().template check<false>();
+		mix_config<channels, downmix, 8>().template check<true>();
+	}
+
+	template <AudioChannelCnt channels, AudioChannelCnt downmix>
+	void benchmark_all()
+	{
+		mix_config<channels, downmix, 2> stereo;
+		mix_config<channels, downmix, 8> surround;
+
+		std::printf("out=%u downmix=%u: 2ch port %.0f ns (scalar %.0f ns), 8ch port %.0f ns (scalar %.0f ns) per period\n",
+			static_cast<u32>(channels), static_cast<u32>(downmix),
+			stereo.template benchmark<true>(), stereo.template benchmark<false>(),
+			surround.template benchmark<true>(), surround.template benchmark<false>());
+	}
+
+	TEST(AudioMix, MatchesScalarStereoOutput)
+	{
+		check_all<AudioChannelCnt::STEREO, AudioChannelCnt::STEREO>();
+		check_all<AudioChannelCnt::STEREO, AudioChannelCnt::SURROUND_5_1>();
+		check_all<AudioChannelCnt::STEREO, AudioChannelCnt::SURROUND_7_1>();
+	}
+
+	TEST(AudioMix, MatchesScalar51Output)
+	{
+		check_all<AudioChannelCnt::SURROUND_5_1, AudioChannelCnt::STEREO>();
+		check_all<AudioChannelCnt::SURROUND_5_1, AudioChannelCnt::SURROUND_5_1>();
+		check_all<AudioChannelCnt::SURROUND_5_1, AudioChannelCnt::SURROUND_7_1>();
+	}
+
+	TEST(AudioMix, MatchesScalar71Output)
+	{
+		check_all<AudioChannelCnt::SURROUND_7_1, AudioChannelCnt::STEREO>();
+		check_all<AudioChannelCnt::SURROUND_7_1, AudioChannelCnt::SURROUND_5_1>();
+		check_all<AudioChannelCnt::SURROUND_7_1, AudioChannelCnt::SURROUND_7_1>();
+	}
+
+	// Micro-benchmark of every channel configuration, run with --gtest_also_run_disabled_tests --gtest_filter=AudioMix.*
+	TEST(AudioMix, DISABLED_Benchmark)
+	{
+		benchmark_all<AudioChannelCnt::STEREO, AudioChannelCnt::STEREO>();
+		benchmark_all<AudioChannelCnt::STEREO, AudioChannelCnt::SURROUND_5_1>();
+		benchmark_all<AudioChannelCnt::STEREO, AudioChannelCnt::SURROUND_7_1>();
+		benchmark_all<AudioChannelCnt::SURROUND_5_1, AudioChannelCnt::STEREO>();
+		benchmark_all<AudioChannelCnt::SURROUND_5_1, AudioChannelCnt::SURROUND_5_1>();
+		benchmark_all<AudioChannelCnt::SURROUND_5_1, AudioChannelCnt::SURROUND_7_1>();
+		benchmark_all<AudioChannelCnt::SURROUND_7_1, AudioChannelCnt::STEREO>();
+		benchmark_all<AudioChannelCnt::SURROUND_7_1, AudioChannelCnt::SURROUND_5_1>();
+		benchmark_all<AudioChannelCnt::SURROUND_7_1, AudioChannelCnt::SURROUND_7_1>();
+	}
+}
@@ -0,0 +1,115 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "Emu/Audio/audio_sinc_resampler.h"
+
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+namespace audio
+{
+	static std::vector<f32> make_sine(u32 channels, u32 frames, f64 freq, f64 rate = 48000.0)
+	{
+		std::vector<f32> data(channels * frames);
+
+		for (u32 i = 0; i < frames; i++)
+		{
+			for (u32 ch = 0; ch < channels; ch++)
+			{
+				data[i * channels + ch] = static_cast<f32>(0.5 * std::sin(2.0 * std::numbers::pi * freq * i / rate + ch));
+			}
+		}
+
+		return data;
+	}
+
+	TEST(AudioResampler, SincPassthroughAtUnityTempo)
+	{
+		sinc_resampler resampler;
+		resampler.set_params(2, 48000);
+		resampler.set_tempo(1.0);
+
+		const std::vector<f32> input = make_sine(2, 480, 1000.0);
+		resampler.put_samples(input.data(), 480);
+
+		// Only the last half window is held back
+		ASSERT_EQ(resampler.samples_available(), 480 - sinc_resampler::taps / 2);
+
+		const auto [buffer, samples] = resampler.get_samples(480);
+		ASSERT_EQ(samples, 480 - sinc_resampler::taps / 2);
+
+		for (u32 i = 0; i < samples * 2; i++)
+		{
+			ASSERT_EQ(buffer[i], input[i]) << "index=" << i;
+		}
+
+		EXPECT_EQ(resampler.samples_available(), 0u);
+	}
+
+	TEST(AudioResampler, SincStretchesSine)
+	{
+		constexpr u32 frames = 4800;
+
+		sinc_resampler resampler;
+		resampler.set_params(2, 48000);
+		resampler.set_tempo(0.5);
+
+		const std::vector<f32> input = make_sine(2, frames, 1000.0);
+
+		// Feed in periods like cellAudio does
+		for (u32 i = 0; i < frames; i += 256)
+		{
+			resampler.put_samples(input.data() + i * 2, std::min(256u, frames - i));
+		}
+
+		EXPECT_NEAR(resampler.get_resample_ratio(), 0.5, 1e-9);
+
+		const auto [buffer, samples] = resampler.get_samples(frames * 4);
+		EXPECT_NEAR(samples, (frames - sinc_resampler::taps / 2) * 2, 2);
+
+		// The output is the same sine at half the frequency
+		const std::vector<f32> expected = make_sine(2, samples, 500.0);
+
+		for (u32 i = sinc_resampler::taps; i < samples; i++)
+		{
+			ASSERT_NEAR(buffer[i * 2 + 0], expected[i * 2 + 0], 2e-3f) << "frame=" << i;
+			ASSERT_NEAR(buffer[i * 2 + 1], expected[i * 2 + 1], 2e-3f) << "frame=" << i;
+		}
+	}
+
+	// Compare latency and throughput of all time stretching backends, run with --gtest_also_run_disabled_tests --gtest_filter=AudioResampler.*
+	TEST(AudioResampler, DISABLED_Benchmark)
+	{
+		constexpr u32 period = 256;
+		constexpr u32 periods = 2000;
+
+		for (const audio_resampler_type type : { audio_resampler_type::soundtouch, audio_resampler_type::sinc })
+		{
+			for (const u32 channels : { 2u, 8u })
+			{
+				const std::vector<f32> input = make_sine(channels, period, 1000.0);
+				const auto backend = audio_resampler::make_backend(type);
+				backend->set_params(channels, 48000);
+				backend->set_tempo(0.9);
+
+				u64 output = 0;
+
+				const auto start = std::chrono::steady_clock::now();
+
+				for (u32 i = 0; i < periods; i++)
+				{
+					backend->put_samples(input.data(), period);
+					output += backend->get_samples(period * 2).second;
+				}
+
+				const f64 ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+				// Input frames which didn't come out yet
+				const f64 latency = periods * period - output * 0.9;
+
+				std::printf("%s %uch: %.1f ns per output frame, %.0f frames (%.2f ms) of latency\n",
+					fmt::format("%s", type).c_str(), channels, ns / output, latency, latency / 48.0);
+			}
+		}
+	}
+}
@@ -0,0 +1,144 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "util/flat_map.hpp"
+
+#include <chrono>
+#include <map>
+#include <random>
+
+namespace utils
+{
+	TEST(FlatMap, Emplace)
+	{
+		flat_map<u32, u32> map;
+
+		EXPECT_TRUE(map.emplace(0x100, 1).second);
+		EXPECT_TRUE(map.emplace(0x300, 3).second);
+		EXPECT_TRUE(map.emplace(0x200, 2).second);
+
+		const auto [it, inserted] = map.emplace(0x200, 5);
+		EXPECT_FALSE(inserted);
+		EXPECT_EQ(it->second, 2u);
+
+		map[0x80] = 7;
+		map[0x300] = 4;
+
+		const std::vector<std::pair<u32, u32>> expected{{0x80, 7}, {0x100, 1}, {0x200, 2}, {0x300, 4}};
+		EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(), expected.end()));
+		EXPECT_EQ(map.crbegin()->first, 0x300u);
+	}
+
+	TEST(FlatMap, Lookup)
+	{
+		flat_map<u32, u32> map;
+
+		for (u32 i = 1; i <= 16; i++)
+		{
+			map.emplace(i * 0x10, i);
+		}
+
+		EXPECT_EQ(map.size(), 16u);
+		EXPECT_TRUE(map.contains(0x40));
+		EXPECT_FALSE(map.contains(0x41));
+		EXPECT_EQ(map.find(0x41), map.end());
+		EXPECT_EQ(map.lower_bound(0x41)->first, 0x50u);
+		EXPECT_EQ(map.upper_bound(0x50)->first, 0x60u);
+		EXPECT_EQ(map.upper_bound(0x100), map.end());
+		EXPECT_EQ(map.upper_bound(0), map.begin());
+
+		EXPECT_EQ(map.erase(0x50), 1u);
+		EXPECT_EQ(map.erase(0x50), 0u);
+		EXPECT_EQ(map.lower_bound(0x41)->first, 0x60u);
+	}
+
+	TEST(FlatMap, EmplaceHint)
+	{
+		flat_map<u32, u32> map;
+
+		// Correct hints
+		map.emplace_hint(map.end(), 1, 1);
+		map.emplace_hint(map.end(), 3, 3);
+		map.emplace_hint(map.begin() + 1, 2, 2);
+
+		// Wrong hints fall back to a regular search
+		map.emplace_hint(map.begin(), 4, 4);
+		map.emplace_hint(map.end(), 0, 0);
+		map.emplace_hint(map.end(), 2, 9);
+
+		ASSERT_EQ(map.size(), 5u);
+
+		for (u32 i = 0; i < 5; i++)
+		{
+			EXPECT_EQ(map.begin()[i].first, i);
+			EXPECT_EQ(map.begin()[i].second, i);
+		}
+	}
+
+	TEST(FlatSet, Emplace)
+	{
+		flat_set<u32> set;
+
+		for (u32 v : {5u, 1u, 9u, 5u, 3u, 1u})
+		{
+			set.emplace(v);
+		}
+
+		const std::vector<u32> expected{1, 3, 5, 9};
+		EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+		EXPECT_EQ(*set.lower_bound(4), 5u);
+		EXPECT_EQ(set.lower_bound(10), set.end());
+		EXPECT_TRUE(set.contains(9));
+		EXPECT_EQ(set.erase(9), 1u);
+		EXPECT_FALSE(set.contains(9));
+	}
+
+	// Compare with std::map on a workload resembling PPU block analysis:
+	// many small per-function maps, mostly ascending insertion with some backward branches, iterated several times.
+	// Run with --gtest_also_run_disabled_tests --gtest_filter=FlatMap.*
+	template <typename Map>
+	static f64 benchmark_blocks(u32 functions)
+	{
+		std::mt19937 rng(1);
+		std::vector<Map> maps(functions);
+
+		u64 sum = 0;
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (u32 f = 0; f < functions; f++)
+		{
+			Map& blocks = maps[f];
+			const u32 base = f * 0x1000;
+			const u32 count = 4 + rng() % 60;
+
+			for (u32 i = 0; i < count; i++)
+			{
+				const u32 addr = rng() % 8 ? base + i * 0x40 : base + (rng() % (i + 1)) * 0x40 + 0x20;
+				blocks[addr] = 0x20;
+			}
+
+			for (u32 pass = 0; pass < 4; pass++)
+			{
+				for (auto& [addr, size] : blocks)
+				{
+					const auto next = blocks.upper_bound(addr);
+					sum += next == blocks.end() ? size : next->first - addr;
+				}
+			}
+		}
+
+		const f64 us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+		EXPECT_NE(sum, 0u);
+		return us;
+	}
+
+	TEST(FlatMap, DISABLED_Benchmark)
+	{
+		for (const u32 functions : {1000u, 20000u})
+		{
+			const f64 node = benchmark_blocks<std::map<u32, u32>>(functions);
+			const f64 flat = benchmark_blocks<flat_map<u32, u32>>(functions);
+			std::printf("%u functions: std::map %.0f us, flat_map %.0f us\n", functions, node, flat);
+		}
+	}
+}
@@ -0,0 +1,65 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "Loader/iso_compressed.h"
+
+#include <filesystem>
+#include <vector>
+
+TEST(CompressedISO, ReadTail)
+{
+	// Image size is not a multiple of the block size (0x10000), the final block is short
+	constexpr u64 image_size = 0x31800;
+	constexpr u64 guard_size = 0x100;
+
+	std::vector<u8> image(image_size);
+
+	for (u64 i = 0; i < image_size; i++)
+	{
+		// Compressible but not uniform
+		image[i] = static_cast<u8>((i / 3) ^ (i >> 12));
+	}
+
+	const std::string dir = (std::filesystem::temp_directory_path() / "rpcs3_test_ciso").string() + '/';
+	ASSERT_TRUE(fs::create_path(dir));
+
+	const std::string iso_path = dir + "image.iso";
+	const std::string ciso_path = dir + "image.ciso";
+
+	ASSERT_TRUE(fs::write_file(iso_path, fs::rewrite, image));
+	ASSERT_TRUE(compress_iso(iso_path, ciso_path));
+
+	const fs::file file = open_iso_image(ciso_path);
+	ASSERT_TRUE(file);
+	EXPECT_EQ(file.size(), image_size);
+
+	const auto check_read = [&](u64 offset, u64 size)
+	{
+		const u64 expected = offset < image_size ? std::min(size, image_size - offset) : 0;
+
+		std::vector<u8> buf(size + guard_size, 0xcd);
+
+		EXPECT_EQ(file.read_at(offset, buf.data(), size), expected) << offset;
+		EXPECT_TRUE(std::equal(buf.begin(), buf.begin() + expected, image.begin() + offset)) << offset;
+
+		// Nothing past the read bytes may change
+		EXPECT_TRUE(std::all_of(buf.begin() + expected, buf.end(), [](u8 v) { return v == 0xcd; })) << offset;
+	};
+
+	// Starts inside the short final block and ends at the end of the image
+	check_read(image_size - 0x800, 0x800);
+	check_read(image_size - 0x800, 0x4000);
+	check_read(0x30000, 0x1800);
+	check_read(image_size - 1, 1);
+
+	// Spans into the short final block
+	check_read(0x2f000, image_size - 0x2f000);
+	check_read(0x1f000, 0x20000);
+
+	// Past the end
+	check_read(image_size, 0x10);
+
+	// Whole image
+	check_read(0, image_size);
+
+	fs::remove_all(dir);
+}
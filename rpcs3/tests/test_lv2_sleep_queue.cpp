@@ -0,0 +1,241 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "Emu/Cell/lv2/sys_sync.h"
+#include "Utilities/BitField.h"
+
+#include <chrono>
+#include <random>
+
+// Minimal sleep queue node with the members used by lv2_obj queue functions (see ppu_thread)
+struct sleep_queue_node
+{
+	union prio_t
+	{
+		u64 all;
+		bf_t<s64, 0, 13> prio;
+		bf_t<s64, 13, 50> order;
+		bf_t<u64, 63, 1> preserve_bit;
+	};
+
+	atomic_t<prio_t> prio{};
+	atomic_bs_t<cpu_flag> state{};
+	sleep_queue_node* next_cpu{};
+	u32 index = 0;
+};
+
+static void sleep_queue_push(sleep_queue_node*& first, sleep_queue_node& node, s32 prio)
+{
+	node.prio.atomic_op([&](sleep_queue_node::prio_t& value)
+	{
+		value.prio = prio;
+	});
+
+	lv2_obj::emplace(first, &node);
+}
+
+// Reference order: FIFO by index, or lowest priority value first then FIFO
+static std::vector<u32> sleep_queue_expected(std::span<const sleep_queue_node> nodes, u32 protocol)
+{
+	std::vector<const sleep_queue_node*> sorted;
+
+	for (const auto& node : nodes)
+	{
+		if (cpu_flag::again - node.state)
+		{
+			sorted.push_back(&node);
+		}
+	}
+
+	if (protocol != SYS_SYNC_FIFO)
+	{
+		std::stable_sort(sorted.begin(), sorted.end(), [](const sleep_queue_node* a, const sleep_queue_node* b)
+		{
+			return a->prio.load().prio < b->prio.load().prio;
+		});
+	}
+
+	std::vector<u32> result;
+
+	for (const auto* node : sorted)
+	{
+		result.push_back(node->index);
+	}
+
+	return result;
+}
+
+TEST(LV2SleepQueue, Schedule)
+{
+	for (const u32 protocol : {+SYS_SYNC_FIFO, +SYS_SYNC_PRIORITY})
+	{
+		std::mt19937 rng(protocol);
+		std::vector<sleep_queue_node> nodes(100);
+		sleep_queue_node* first = nullptr;
+
+		for (u32 i = 0; i < nodes.size(); i++)
+		{
+			nodes[i].index = i;
+			sleep_queue_push(first, nodes[i], rng() % 8);
+		}
+
+		std::vector<u32> result;
+
+		while (const auto node = lv2_obj::schedule<sleep_queue_node>(first, protocol))
+		{
+			EXPECT_EQ(node->next_cpu, nullptr);
+			result.push_back(node->index);
+		}
+
+		EXPECT_EQ(result, sleep_queue_expected(nodes, protocol));
+	}
+}
+
+TEST(LV2SleepQueue, ScheduleAll)
+{
+	for (const u32 protocol : {+SYS_SYNC_FIFO, +SYS_SYNC_PRIORITY})
+	{
+		std::mt19937 rng(protocol);
+		std::vector<sleep_queue_node> nodes(100);
+		sleep_queue_node* first = nullptr;
+
+		for (u32 i = 0; i < nodes.size(); i++)
+		{
+			nodes[i].index = i;
+			sleep_queue_push(first, nodes[i], rng() % 8);
+
+			if (rng() % 10 == 0)
+			{
+				// Must stay queued
+				nodes[i].state += cpu_flag::again;
+			}
+		}
+
+		std::vector<u32> result;
+
+		const usz count = lv2_obj::schedule_all<sleep_queue_node>(first, protocol, [&](sleep_queue_node* node)
+		{
+			EXPECT_EQ(node->next_cpu, nullptr);
+			result.push_back(node->index);
+		});
+
+		EXPECT_EQ(count, result.size());
+		EXPECT_EQ(result, sleep_queue_expected(nodes, protocol));
+
+		// Only nodes with cpu_flag::again are left
+		usz left = 0;
+
+		for (auto node = first; node; node = node->next_cpu)
+		{
+			EXPECT_TRUE(node->state & cpu_flag::again);
+			left++;
+		}
+
+		EXPECT_EQ(left + count, nodes.size());
+	}
+}
+
+TEST(LV2SleepQueue, ScheduleAllMatchesSchedule)
+{
+	for (const u32 protocol : {+SYS_SYNC_FIFO, +SYS_SYNC_PRIORITY})
+	{
+		std::mt19937 rng(protocol + 1);
+		std::vector<sleep_queue_node> nodes0(100), nodes1(100);
+		sleep_queue_node* first0 = nullptr;
+		sleep_queue_node* first1 = nullptr;
+
+		for (u32 i = 0; i < nodes0.size(); i++)
+		{
+			const s32 prio = rng() % 4;
+
+			// Negative order: thread priority changed while waiting (see lv2_obj::set_priority)
+			const s64 order = rng() % 4 == 0 ? ~s64{rng() % 1000} : s64{rng() % 1000};
+
+			for (auto [nodes, first] : {std::pair{&nodes0, &first0}, std::pair{&nodes1, &first1}})
+			{
+				auto& node = (*nodes)[i];
+				node.index = i;
+				sleep_queue_push(*first, node, prio);
+
+				node.prio.atomic_op([&](sleep_queue_node::prio_t& value)
+				{
+					value.order = order;
+				});
+			}
+		}
+
+		std::vector<u32> expected, result;
+
+		while (const auto node = lv2_obj::schedule<sleep_queue_node>(first0, protocol))
+		{
+			expected.push_back(node->index);
+		}
+
+		lv2_obj::schedule_all<sleep_queue_node>(first1, protocol, [&](sleep_queue_node* node)
+		{
+			result.push_back(node->index);
+		});
+
+		EXPECT_EQ(result, expected);
+	}
+}
+
+// Stress the sleep queue with many waiters: single wakeups at a steady queue depth, and waking all waiters
+// Run with --gtest_also_run_disabled_tests --gtest_filter=LV2SleepQueue.*
+TEST(LV2SleepQueue, DISABLED_Benchmark)
+{
+	for (const u32 protocol : {+SYS_SYNC_FIFO, +SYS_SYNC_PRIORITY})
+	{
+		for (const u32 depth : {4u, 64u, 1024u})
+		{
+			std::mt19937 rng(depth);
+			std::vector<sleep_queue_node> nodes(depth + 1);
+			sleep_queue_node* first = nullptr;
+
+			for (auto& node : nodes)
+			{
+				sleep_queue_push(first, node, rng() % 3072);
+			}
+
+			// Wake one waiter and put it back to sleep, the queue keeps the same depth
+			const u32 wakeups = 1'000'000 / depth + 1000;
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (u32 i = 0; i < wakeups; i++)
+			{
+				const auto node = ensure(lv2_obj::schedule<sleep_queue_node>(first, protocol));
+				sleep_queue_push(first, *node, rng() % 3072);
+			}
+
+			const f64 single_ns = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - start).count() / wakeups;
+
+			// Wake all waiters one by one, then in a single pass
+			while (lv2_obj::schedule<sleep_queue_node>(first, protocol));
+
+			for (auto& node : nodes)
+			{
+				sleep_queue_push(first, node, rng() % 3072);
+			}
+
+			start = std::chrono::steady_clock::now();
+
+			while (lv2_obj::schedule<sleep_queue_node>(first, protocol));
+
+			const f64 loop_us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+			for (auto& node : nodes)
+			{
+				sleep_queue_push(first, node, rng() % 3072);
+			}
+
+			start = std::chrono::steady_clock::now();
+
+			EXPECT_EQ(lv2_obj::schedule_all<sleep_queue_node>(first, protocol, [](sleep_queue_node*) {}), nodes.size());
+
+			const f64 all_us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+			std::printf("%s, %u waiters: schedule() %.1f ns, wake all: schedule() loop %.1f us, schedule_all() %.1f us\n",
+				protocol == SYS_SYNC_FIFO ? "FIFO" : "Priority", depth + 1, single_ns, loop_us, all_us);
+		}
+	}
+}
@@ -0,0 +1,134 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "Emu/Cell/MFC.h"
+#include "util/asm.hpp"
+
+#include <array>
+#include <span>
+#include <vector>
+
+// Same layout as the list element of spu_thread::do_list_transfer
+struct mfc_list_test_element
+{
+	u8 sb;
+	u8 pad;
+	u16 ts;
+	u32 ea;
+};
+
+// Execute a list GET the way do_list_transfer does it: coalesce, then copy in 16-byte units unless the size is small
+static std::vector<u32> mfc_list_test_get(std::span<const mfc_list_test_element> list, std::span<const u8> mem, std::span<u8> ls, u32 lsa)
+{
+	std::vector<u32> transfers;
+
+	for (u32 index = 0; index < list.size(); index++)
+	{
+		u32 size = list[index].ts & 0x7fff;
+		const u32 addr = list[index].ea;
+
+		index += mfc_list_coalesce(list.data() + index, ::size32(list) - index, size, 0x4000, ::size32(mem));
+		transfers.push_back(size);
+
+		const u8* src = mem.data() + addr;
+		u8* dst = ls.data() + lsa + (addr & 0xf);
+
+		if (size < 16)
+		{
+			std::memcpy(dst, src, size);
+		}
+		else
+		{
+			for (u32 _size = size; _size; _size -= 16, src += 16, dst += 16)
+			{
+				// Must never wrap around
+				EXPECT_EQ(_size % 16, 0);
+				EXPECT_LE(dst + 16, ls.data() + ls.size());
+
+				if (_size % 16 || dst + 16 > ls.data() + ls.size())
+				{
+					return transfers;
+				}
+
+				std::memcpy(dst, src, 16);
+			}
+		}
+
+		lsa += utils::align(size, 16);
+	}
+
+	return transfers;
+}
+
+TEST(MFCList, CoalesceOnly16ByteMultiples)
+{
+	std::array<u8, 0x200> mem;
+
+	for (usz i = 0; i < mem.size(); i++)
+	{
+		mem[i] = static_cast<u8>(i * 7 + 1);
+	}
+
+	std::array<u8, 0x100> ls;
+	ls.fill(0xcd);
+
+	const mfc_list_test_element list[]{{0, 0, 16, 0x100}, {0, 0, 16, 0x110}, {0, 0, 8, 0x120}};
+
+	// The trailing 8-byte element must not be merged into the run
+	EXPECT_EQ(mfc_list_test_get(list, mem, ls, 0x40), (std::vector<u32>{32, 8}));
+
+	// Bytes written: 32 bytes at 0x40 and 8 bytes at the next 16-byte aligned LS address
+	for (u32 i = 0; i < ls.size(); i++)
+	{
+		if (i >= 0x40 && i < 0x60)
+		{
+			EXPECT_EQ(ls[i], mem[0x100 + i - 0x40]) << i;
+		}
+		else if (i >= 0x60 && i < 0x68)
+		{
+			EXPECT_EQ(ls[i], mem[0x120 + i - 0x60]) << i;
+		}
+		else
+		{
+			EXPECT_EQ(ls[i], 0xcd) << i;
+		}
+	}
+}
+
+TEST(MFCList, CoalesceLimits)
+{
+	u32 size = 0;
+
+	// Small leading element
+	const mfc_list_test_element small[]{{0, 0, 8, 0x100}, {0, 0, 16, 0x108}};
+	size = 8;
+	EXPECT_EQ(mfc_list_coalesce(small, 2, size, 0x4000, 0x1000), 0);
+	EXPECT_EQ(size, 8);
+
+	// Stall-and-notify on the first element
+	const mfc_list_test_element stall[]{{0x80, 0, 16, 0x100}, {0, 0, 16, 0x110}};
+	size = 16;
+	EXPECT_EQ(mfc_list_coalesce(stall, 2, size, 0x4000, 0x1000), 0);
+
+	// Stall-and-notify on the second element ends the run after it
+	const mfc_list_test_element stall2[]{{0, 0, 16, 0x100}, {0x80, 0, 16, 0x110}, {0, 0, 16, 0x120}};
+	size = 16;
+	EXPECT_EQ(mfc_list_coalesce(stall2, 3, size, 0x4000, 0x1000), 1);
+	EXPECT_EQ(size, 32);
+
+	// Not contiguous in EA
+	const mfc_list_test_element gap[]{{0, 0, 16, 0x100}, {0, 0, 16, 0x120}};
+	size = 16;
+	EXPECT_EQ(mfc_list_coalesce(gap, 2, size, 0x4000, 0x1000), 0);
+
+	// Size limit
+	const mfc_list_test_element big[]{{0, 0, 0x300, 0x100}, {0, 0, 0x200, 0x400}};
+	size = 0x300;
+	EXPECT_EQ(mfc_list_coalesce(big, 2, size, 0x400, 0x1000), 0);
+	EXPECT_EQ(size, 0x300);
+
+	// Count limit
+	const mfc_list_test_element many[]{{0, 0, 16, 0x100}, {0, 0, 16, 0x110}, {0, 0, 16, 0x120}};
+	size = 16;
+	EXPECT_EQ(mfc_list_coalesce(many, 2, size, 0x4000, 0x1000), 1);
+	EXPECT_EQ(size, 32);
+}
@@ -0,0 +1,129 @@
+#include "stdafx.h"
+#include <gtest/gtest.h>
+#include "util/yuv_convert.hpp"
+
+#include <chrono>
+#include <random>
+
+namespace utils
+{
+	struct yuv420_image
+	{
+		u32 width;
+		u32 height;
+		std::vector<u8> y;
+		std::vector<u8> u;
+		std::vector<u8> v;
+
+		yuv420_image(u32 w, u32 h, u32 seed)
+			: width(w)
+			, height(h)
+			, y(w * h)
+			, u(((w + 1) / 2) * ((h + 1) / 2))
+			, v(u.size())
+		{
+			std::mt19937 rng(seed);
+			for (u8& c : y) c = static_cast<u8>(rng());
+			for (u8& c : u) c = static_cast<u8>(rng());
+			for (u8& c : v) c = static_cast<u8>(rng());
+		}
+
+		yuv420_planes planes() const
+		{
+			return { y.data(), u.data(), v.data(), width, (width + 1) / 2 };
+		}
+	};
+
+	TEST(YuvConvert, MatchesReference)
+	{
+		for (const u32 width : { 1u, 15u, 16u, 33u, 63u, 720u })
+		{
+			const yuv420_image image(width, 9, width);
+
+			for (const yuv_color_matrix matrix : { yuv_color_matrix::bt601, yuv_color_matrix::bt709 })
+			{
+				for (const bool full_range : { false, true })
+				{
+					for (const rgb32_layout layout : { rgb32_layout::argb, rgb32_layout::rgba })
+					{
+						const yuv_to_rgb32_params params{ matrix, full_range, layout, 0x7f };
+
+						std::vector<u8> expected(width * 4 * image.height);
+						std::vector<u8> result(expected.size());
+
+						convert_yuv420_to_rgb32_ref(image.planes(), expected.data(), width * 4, width, 0, image.height, params);
+						convert_yuv420_to_rgb32(image.planes(), result.data(), width * 4, width, image.height, params);
+
+						ASSERT_EQ(result, expected) << "width=" << width << " matrix=" << +static_cast<u8>(matrix) << " full_range=" << full_range << " layout=" << +static_cast<u8>(layout);
+					}
+				}
+			}
+		}
+	}
+
+	TEST(YuvConvert, KnownColors)
+	{
+		// Broadcast range BT.601: black, white and pure red
+		const u8 y[4] = { 16, 235, 81, 81 };
+		const u8 u[2] = { 128, 90 };
+		const u8 v[2] = { 128, 240 };
+
+		u8 out[16]{};
+
+		convert_yuv420_to_rgb32_ref({ y, u, v, 4, 2 }, out, 16, 4, 0, 1, { yuv_color_matrix::bt601, false, rgb32_layout::argb, 0x80 });
+
+		const u8 black[4] = { 0x80, 0, 0, 0 };
+		const u8 white[4] = { 0x80, 255, 255, 255 };
+		EXPECT_EQ(std::memcmp(out + 0, black, 4), 0);
+		EXPECT_EQ(std::memcmp(out + 4, white, 4), 0);
+
+		for (const u32 px : { 2u, 3u })
+		{
+			EXPECT_EQ(out[px * 4 + 0], 0x80);
+			EXPECT_GE(out[px * 4 + 1], 253);
+			EXPECT_LE(out[px * 4 + 2], 2);
+			EXPECT_LE(out[px * 4 + 3], 2);
+		}
+	}
+
+	TEST(YuvConvert, Slices)
+	{
+		const yuv420_image image(1280, 720, 1);
+		const yuv_to_rgb32_params params{ yuv_color_matrix::bt709, false, rgb32_layout::rgba, 0xff };
+
+		// Padded pitch like a guest buffer with a larger stride
+		const u32 pitch = 1280 * 4 + 64;
+
+		std::vector<u8> expected(pitch * 720);
+		std::vector<u8> result(expected.size());
+
+		convert_yuv420_to_rgb32_ref(image.planes(), expected.data(), pitch, 1280, 0, 720, params);
+		convert_yuv420_to_rgb32(image.planes(), result.data(), pitch, 1280, 720, params, 4);
+
+		ASSERT_EQ(result, expected);
+	}
+
+	// Run with --gtest_also_run_disabled_tests --gtest_filter=YuvConvert.*
+	TEST(YuvConvert, DISABLED_Benchmark)
+	{
+		const yuv420_image image(1920, 1080, 1);
+		const yuv_to_rgb32_params params{};
+		std::vector<u8> result(1920 * 4 * 1080);
+
+		for (const u32 threads : { 0u, 1u, 2u, 4u })
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			for (u32 i = 0; i < 100; i++)
+			{
+				if (threads)
+					convert_yuv420_to_rgb32(image.planes(), result.data(), 1920 * 4, 1920, 1080, params, threads);
+				else
+					convert_yuv420_to_rgb32_ref(image.planes(), result.data(), 1920 * 4, 1920, 0, 1080, params);
+			}
+
+			const f64 us = std::chrono::duration<f64, std::micro>(std::chrono::steady_clock::now() - start).count() / 100;
+			std::printf("1080p with %u thread(s) (0 = reference): %.1f us per frame\n", threads, us);
+		}
+	}
+}
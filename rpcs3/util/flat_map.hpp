@@ -0,0 +1,246 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace utils
+{
+	// Sorted vector with a subset of the std::map interface.
+	// Meant for small maps which are mostly appended to in key order and iterated far more often than modified.
+	// Unlike std::map, insertion and erasure invalidate all iterators.
+	template <typename K, typename V, typename Compare = std::less<K>, typename Alloc = std::allocator<std::pair<K, V>>>
+	class flat_map
+	{
+	public:
+		using key_type = K;
+		using mapped_type = V;
+		using value_type = std::pair<K, V>;
+		using storage_type = std::vector<value_type, Alloc>;
+		using size_type = typename storage_type::size_type;
+		using iterator = typename storage_type::iterator;
+		using const_iterator = typename storage_type::const_iterator;
+		using reverse_iterator = typename storage_type::reverse_iterator;
+		using const_reverse_iterator = typename storage_type::const_reverse_iterator;
+
+	private:
+		storage_type m_data;
+
+		static constexpr auto s_less = [](const value_type& a, const K& key) { return Compare{}(a.first, key); };
+		static constexpr auto s_greater = [](const K& key, const value_type& a) { return Compare{}(key, a.first); };
+
+	public:
+		flat_map() = default;
+
+		explicit flat_map(const Alloc& alloc)
+			: m_data(alloc)
+		{
+		}
+
+		iterator begin() noexcept { return m_data.begin(); }
+		iterator end() noexcept { return m_data.end(); }
+		const_iterator begin() const noexcept { return m_data.begin(); }
+		const_iterator end() const noexcept { return m_data.end(); }
+		const_iterator cbegin() const noexcept { return m_data.cbegin(); }
+		const_iterator cend() const noexcept { return m_data.cend(); }
+		reverse_iterator rbegin() noexcept { return m_data.rbegin(); }
+		reverse_iterator rend() noexcept { return m_data.rend(); }
+		const_reverse_iterator rbegin() const noexcept { return m_data.rbegin(); }
+		const_reverse_iterator rend() const noexcept { return m_data.rend(); }
+		const_reverse_iterator crbegin() const noexcept { return m_data.crbegin(); }
+		const_reverse_iterator crend() const noexcept { return m_data.crend(); }
+
+		bool empty() const noexcept { return m_data.empty(); }
+		size_type size() const noexcept { return m_data.size(); }
+		void clear() noexcept { m_data.clear(); }
+		void reserve(size_type count) { m_data.reserve(count); }
+
+		iterator lower_bound(const K& key) { return std::lower_bound(m_data.begin(), m_data.end(), key, s_less); }
+		const_iterator lower_bound(const K& key) const { return std::lower_bound(m_data.begin(), m_data.end(), key, s_less); }
+		iterator upper_bound(const K& key) { return std::upper_bound(m_data.begin(), m_data.end(), key, s_greater); }
+		const_iterator upper_bound(const K& key) const { return std::upper_bound(m_data.begin(), m_data.end(), key, s_greater); }
+
+		iterator find(const K& key)
+		{
+			const auto it = lower_bound(key);
+			return it != m_data.end() && !Compare{}(key, it->first) ? it : m_data.end();
+		}
+
+		const_iterator find(const K& key) const
+		{
+			const auto it = lower_bound(key);
+			return it != m_data.end() && !Compare{}(key, it->first) ? it : m_data.end();
+		}
+
+		bool contains(const K& key) const { return find(key) != m_data.end(); }
+		size_type count(const K& key) const { return contains(key); }
+
+		// Insert if the key doesn't exist yet (appending in key order is O(1))
+		template <typename... Args>
+		std::pair<iterator, bool> emplace(const K& key, Args&&... args)
+		{
+			if (m_data.empty() || Compare{}(m_data.back().first, key))
+			{
+				m_data.emplace_back(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+				return {m_data.end() - 1, true};
+			}
+
+			const auto it = lower_bound(key);
+
+			if (it != m_data.end() && !Compare{}(key, it->first))
+			{
+				return {it, false};
+			}
+
+			return {m_data.emplace(it, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...)), true};
+		}
+
+		template <typename... Args>
+		std::pair<iterator, bool> try_emplace(const K& key, Args&&... args)
+		{
+			return emplace(key, std::forward<Args>(args)...);
+		}
+
+		template <typename... Args>
+		iterator emplace_hint(const_iterator hint, const K& key, Args&&... args)
+		{
+			// Use the hint if the key belongs right before it
+			if ((hint == m_data.cend() || Compare{}(key, hint->first)) && (hint == m_data.cbegin() || Compare{}((hint - 1)->first, key)))
+			{
+				return m_data.emplace(hint, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			}
+
+			return emplace(key, std::forward<Args>(args)...).first;
+		}
+
+		std::pair<iterator, bool> insert(const value_type& value)
+		{
+			return emplace(value.first, value.second);
+		}
+
+		V& operator[](const K& key)
+		{
+			return emplace(key).first->second;
+		}
+
+		iterator erase(const_iterator pos)
+		{
+			return m_data.erase(pos);
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			return m_data.erase(first, last);
+		}
+
+		size_type erase(const K& key)
+		{
+			const auto it = find(key);
+
+			if (it == m_data.end())
+			{
+				return 0;
+			}
+
+			m_data.erase(it);
+			return 1;
+		}
+
+		bool operator==(const flat_map& rhs) const = default;
+	};
+
+	// Sorted vector with a subset of the std::set interface, see flat_map
+	template <typename K, typename Compare = std::less<K>, typename Alloc = std::allocator<K>>
+	class flat_set
+	{
+	public:
+		using key_type = K;
+		using value_type = K;
+		using storage_type = std::vector<K, Alloc>;
+		using size_type = typename storage_type::size_type;
+		using iterator = typename storage_type::const_iterator;
+		using const_iterator = typename storage_type::const_iterator;
+		using reverse_iterator = typename storage_type::const_reverse_iterator;
+		using const_reverse_iterator = typename storage_type::const_reverse_iterator;
+
+	private:
+		storage_type m_data;
+
+	public:
+		flat_set() = default;
+
+		explicit flat_set(const Alloc& alloc)
+			: m_data(alloc)
+		{
+		}
+
+		const_iterator begin() const noexcept { return m_data.cbegin(); }
+		const_iterator end() const noexcept { return m_data.cend(); }
+		const_iterator cbegin() const noexcept { return m_data.cbegin(); }
+		const_iterator cend() const noexcept { return m_data.cend(); }
+		const_reverse_iterator rbegin() const noexcept { return m_data.crbegin(); }
+		const_reverse_iterator rend() const noexcept { return m_data.crend(); }
+
+		bool empty() const noexcept { return m_data.empty(); }
+		size_type size() const noexcept { return m_data.size(); }
+		void clear() noexcept { m_data.clear(); }
+		void reserve(size_type count) { m_data.reserve(count); }
+
+		const_iterator lower_bound(const K& key) const { return std::lower_bound(m_data.begin(), m_data.end(), key, Compare{}); }
+		const_iterator upper_bound(const K& key) const { return std::upper_bound(m_data.begin(), m_data.end(), key, Compare{}); }
+
+		const_iterator find(const K& key) const
+		{
+			const auto it = lower_bound(key);
+			return it != m_data.end() && !Compare{}(key, *it) ? it : m_data.end();
+		}
+
+		bool contains(const K& key) const { return find(key) != m_data.end(); }
+		size_type count(const K& key) const { return contains(key); }
+
+		std::pair<const_iterator, bool> emplace(const K& key)
+		{
+			if (m_data.empty() || Compare{}(m_data.back(), key))
+			{
+				m_data.push_back(key);
+				return {m_data.cend() - 1, true};
+			}
+
+			const auto it = lower_bound(key);
+
+			if (it != m_data.end() && !Compare{}(key, *it))
+			{
+				return {it, false};
+			}
+
+			return {m_data.insert(it, key), true};
+		}
+
+		std::pair<const_iterator, bool> insert(const K& key)
+		{
+			return emplace(key);
+		}
+
+		const_iterator erase(const_iterator pos)
+		{
+			return m_data.erase(pos);
+		}
+
+		size_type erase(const K& key)
+		{
+			const auto it = find(key);
+
+			if (it == m_data.end())
+			{
+				return 0;
+			}
+
+			m_data.erase(it);
+			return 1;
+		}
+
+		bool operator==(const flat_set& rhs) const = default;
+	};
+}
@@ -103,6 +103,9 @@ namespace utils
 		// Unmap shared memory, undoing map_self()
 		void unmap_self();
 
+		// Get a path which other processes can open to map the same memory (empty if unsupported)
+		std::string get_shared_path() const;
+
 		// Get memory mapped by map_self()
 		u8* get() const
 		{
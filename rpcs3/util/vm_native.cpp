@@ -1079,4 +1079,18 @@ namespace utils
 			this->unmap(ptr);
 		}
 	}
+
+	std::string shm::get_shared_path() const
+	{
+#ifdef _WIN32
+		// Sparse file storage
+		return m_storage;
+#elif defined(__linux__)
+		// Works for memfd as well
+		return fmt::format("/proc/%d/fd/%d", ::getpid(), m_file);
+#else
+		// Unlinked POSIX shared memory
+		return {};
+#endif
+	}
 } // namespace utils
@@ -0,0 +1,287 @@
+#include "stdafx.h"
+#include "util/yuv_convert.hpp"
+#include "util/sysinfo.hpp"
+#include "util/asm.hpp"
+#include "util/v128.hpp"
+#include "util/simd.hpp"
+#include "Utilities/Thread.h"
+
+#include <cmath>
+
+#if defined(ARCH_X64)
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#if defined(_MSC_VER) || !defined(__SSE2__)
+#define AVX2_FUNC
+#else
+#define AVX2_FUNC __attribute__((__target__("avx2")))
+#endif
+
+#if defined(__AVX2__)
+[[maybe_unused]] constexpr bool s_use_avx2 = true;
+#elif defined(ARCH_X64)
+[[maybe_unused]] const bool s_use_avx2 = utils::has_avx2();
+#else
+[[maybe_unused]] constexpr bool s_use_avx2 = false;
+#endif
+
+namespace
+{
+	// Fixed point coefficients with 6 fractional bits, small enough to keep every partial sum in 16 bits.
+	// The luma term includes the offset and the rounding bias, chroma samples are centered around zero.
+	struct yuv_coefs
+	{
+		s16 y_mul;
+		s16 y_bias;
+		s16 r_v;
+		s16 g_u;
+		s16 g_v;
+		s16 b_u;
+	};
+
+	yuv_coefs make_coefs(const utils::yuv_to_rgb32_params& params)
+	{
+		const bool bt709 = params.matrix == utils::yuv_color_matrix::bt709;
+		const f64 kr = bt709 ? 0.2126 : 0.299;
+		const f64 kb = bt709 ? 0.0722 : 0.114;
+		const f64 kg = 1.0 - kr - kb;
+
+		const f64 y_scale = params.full_range ? 1.0 : 255.0 / 219.0;
+		const f64 c_scale = params.full_range ? 1.0 : 255.0 / 224.0;
+		const s32 y_offset = params.full_range ? 0 : 16;
+
+		const auto fixed = [](f64 v) { return static_cast<s16>(std::lround(v * 64.0)); };
+
+		yuv_coefs c{};
+		c.y_mul = fixed(y_scale);
+		c.y_bias = static_cast<s16>(32 - y_offset * c.y_mul);
+		c.r_v = fixed(2.0 * (1.0 - kr) * c_scale);
+		c.g_u = fixed(-2.0 * (1.0 - kb) * kb / kg * c_scale);
+		c.g_v = fixed(-2.0 * (1.0 - kr) * kr / kg * c_scale);
+		c.b_u = fixed(2.0 * (1.0 - kb) * c_scale);
+		return c;
+	}
+
+	// Order in which the R, G, B and A channels are written
+	struct channel_order
+	{
+		u8 r, g, b, a;
+	};
+
+	channel_order get_order(utils::rgb32_layout layout)
+	{
+		return layout == utils::rgb32_layout::argb ? channel_order{1, 2, 3, 0} : channel_order{0, 1, 2, 3};
+	}
+
+	// Emulates the saturating 16-bit add and the final unsigned pack of the vector paths
+	inline u8 to_channel(s32 luma, s32 chroma)
+	{
+		return static_cast<u8>(std::clamp(std::clamp(luma + chroma, -32768, 32767) >> 6, 0, 255));
+	}
+
+	void convert_row_scalar(const u8* y, const u8* u, const u8* v, u8* dst, u32 x_begin, u32 x_end, const yuv_coefs& c, channel_order order, u8 alpha)
+	{
+		for (u32 x = x_begin; x < x_end; x++)
+		{
+			const s32 cu = u[x / 2] - 128;
+			const s32 cv = v[x / 2] - 128;
+			const s32 luma = static_cast<s16>(y[x] * c.y_mul + c.y_bias);
+
+			u8* const px = dst + x * 4;
+			px[order.r] = to_channel(luma, cv * c.r_v);
+			px[order.g] = to_channel(luma, cu * c.g_u + cv * c.g_v);
+			px[order.b] = to_channel(luma, cu * c.b_u);
+			px[order.a] = alpha;
+		}
+	}
+
+	// Converts 16 pixels per iteration, returns the number of pixels converted
+	u32 convert_row_v128(const u8* y, const u8* u, const u8* v, u8* dst, u32 width, const yuv_coefs& c, bool argb, u8 alpha)
+	{
+		const v128 zero{};
+		const v128 c128 = gv_bcst16(128);
+		const v128 y_mul = gv_bcst16(c.y_mul);
+		const v128 y_bias = gv_bcst16(c.y_bias);
+		const v128 r_v = gv_bcst16(c.r_v);
+		const v128 g_u = gv_bcst16(c.g_u);
+		const v128 g_v = gv_bcst16(c.g_v);
+		const v128 b_u = gv_bcst16(c.b_u);
+		const v128 a = gv_bcst8(alpha);
+
+		u32 x = 0;
+
+		for (; x + 16 <= width; x += 16)
+		{
+			const v128 luma = v128::loadu(y + x);
+			const v128 cu = gv_sub16(gv_unpacklo8(v128::from64(read_from_ptr<u64>(u + x / 2)), zero), c128);
+			const v128 cv = gv_sub16(gv_unpacklo8(v128::from64(read_from_ptr<u64>(v + x / 2)), zero), c128);
+
+			const v128 y0 = gv_add16(gv_mul16(gv_unpacklo8(luma, zero), y_mul), y_bias);
+			const v128 y1 = gv_add16(gv_mul16(gv_unpackhi8(luma, zero), y_mul), y_bias);
+
+			// Each chroma term covers two horizontal pixels
+			const v128 tr = gv_mul16(cv, r_v);
+			const v128 tg = gv_add16(gv_mul16(cu, g_u), gv_mul16(cv, g_v));
+			const v128 tb = gv_mul16(cu, b_u);
+
+			const v128 r = gv_packus_s16(gv_sar16(gv_adds_s16(y0, gv_unpacklo16(tr, tr)), 6), gv_sar16(gv_adds_s16(y1, gv_unpackhi16(tr, tr)), 6));
+			const v128 g = gv_packus_s16(gv_sar16(gv_adds_s16(y0, gv_unpacklo16(tg, tg)), 6), gv_sar16(gv_adds_s16(y1, gv_unpackhi16(tg, tg)), 6));
+			const v128 b = gv_packus_s16(gv_sar16(gv_adds_s16(y0, gv_unpacklo16(tb, tb)), 6), gv_sar16(gv_adds_s16(y1, gv_unpackhi16(tb, tb)), 6));
+
+			const v128 c01_lo = argb ? gv_unpacklo8(a, r) : gv_unpacklo8(r, g);
+			const v128 c01_hi = argb ? gv_unpackhi8(a, r) : gv_unpackhi8(r, g);
+			const v128 c23_lo = argb ? gv_unpacklo8(g, b) : gv_unpacklo8(b, a);
+			const v128 c23_hi = argb ? gv_unpackhi8(g, b) : gv_unpackhi8(b, a);
+
+			v128::storeu(gv_unpacklo16(c01_lo, c23_lo), dst + x * 4, 0);
+			v128::storeu(gv_unpackhi16(c01_lo, c23_lo), dst + x * 4, 1);
+			v128::storeu(gv_unpacklo16(c01_hi, c23_hi), dst + x * 4, 2);
+			v128::storeu(gv_unpackhi16(c01_hi, c23_hi), dst + x * 4, 3);
+		}
+
+		return x;
+	}
+
+#if defined(ARCH_X64)
+	// Same as above with 32 pixels per iteration
+	AVX2_FUNC u32 convert_row_avx2(const u8* y, const u8* u, const u8* v, u8* dst, u32 width, const yuv_coefs& c, bool argb, u8 alpha)
+	{
+		const __m256i c128 = _mm256_set1_epi16(128);
+		const __m256i y_mul = _mm256_set1_epi16(c.y_mul);
+		const __m256i y_bias = _mm256_set1_epi16(c.y_bias);
+		const __m256i r_v = _mm256_set1_epi16(c.r_v);
+		const __m256i g_u = _mm256_set1_epi16(c.g_u);
+		const __m256i g_v = _mm256_set1_epi16(c.g_v);
+		const __m256i b_u = _mm256_set1_epi16(c.b_u);
+		const __m256i a = _mm256_set1_epi8(static_cast<s8>(alpha));
+
+		u32 x = 0;
+
+		for (; x + 32 <= width; x += 32)
+		{
+			const __m256i y0 = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x))), y_mul), y_bias);
+			const __m256i y1 = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y + x + 16))), y_mul), y_bias);
+			const __m256i cu = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(u + x / 2))), c128);
+			const __m256i cv = _mm256_sub_epi16(_mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v + x / 2))), c128);
+
+			// Reorder the chroma terms to 0-3, 8-11 | 4-7, 12-15 so that the in-lane unpacks duplicate them in pixel order
+			const __m256i tr = _mm256_permute4x64_epi64(_mm256_mullo_epi16(cv, r_v), 0xd8);
+			const __m256i tg = _mm256_permute4x64_epi64(_mm256_add_epi16(_mm256_mullo_epi16(cu, g_u), _mm256_mullo_epi16(cv, g_v)), 0xd8);
+			const __m256i tb = _mm256_permute4x64_epi64(_mm256_mullo_epi16(cu, b_u), 0xd8);
+
+			// Lanes hold pixels 0-7, 16-23 | 8-15, 24-31 after packing
+			const __m256i r = _mm256_packus_epi16(
+				_mm256_srai_epi16(_mm256_adds_epi16(y0, _mm256_unpacklo_epi16(tr, tr)), 6),
+				_mm256_srai_epi16(_mm256_adds_epi16(y1, _mm256_unpackhi_epi16(tr, tr)), 6));
+			const __m256i g = _mm256_packus_epi16(
+				_mm256_srai_epi16(_mm256_adds_epi16(y0, _mm256_unpacklo_epi16(tg, tg)), 6),
+				_mm256_srai_epi16(_mm256_adds_epi16(y1, _mm256_unpackhi_epi16(tg, tg)), 6));
+			const __m256i b = _mm256_packus_epi16(
+				_mm256_srai_epi16(_mm256_adds_epi16(y0, _mm256_unpacklo_epi16(tb, tb)), 6),
+				_mm256_srai_epi16(_mm256_adds_epi16(y1, _mm256_unpackhi_epi16(tb, tb)), 6));
+
+			const __m256i c01_lo = argb ? _mm256_unpacklo_epi8(a, r) : _mm256_unpacklo_epi8(r, g);
+			const __m256i c01_hi = argb ? _mm256_unpackhi_epi8(a, r) : _mm256_unpackhi_epi8(r, g);
+			const __m256i c23_lo = argb ? _mm256_unpacklo_epi8(g, b) : _mm256_unpacklo_epi8(b, a);
+			const __m256i c23_hi = argb ? _mm256_unpackhi_epi8(g, b) : _mm256_unpackhi_epi8(b, a);
+
+			// Lanes hold pixels 0-3 | 8-11 (p0), 4-7 | 12-15 (p1), and the same for 16-31 (p2, p3)
+			const __m256i p0 = _mm256_unpacklo_epi16(c01_lo, c23_lo);
+			const __m256i p1 = _mm256_unpackhi_epi16(c01_lo, c23_lo);
+			const __m256i p2 = _mm256_unpacklo_epi16(c01_hi, c23_hi);
+			const __m256i p3 = _mm256_unpackhi_epi16(c01_hi, c23_hi);
+
+			__m256i* const out = reinterpret_cast<__m256i*>(dst + x * 4);
+			_mm256_storeu_si256(out + 0, _mm256_permute2x128_si256(p0, p1, 0x20));
+			_mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(p0, p1, 0x31));
+			_mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(p2, p3, 0x20));
+			_mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(p2, p3, 0x31));
+		}
+
+		_mm256_zeroupper();
+		return x;
+	}
+#endif
+
+	void convert_rows(const utils::yuv420_planes& src, u8* dst, u32 dst_pitch, u32 width, u32 row_begin, u32 row_end, const yuv_coefs& c, const utils::yuv_to_rgb32_params& params)
+	{
+		const bool argb = params.layout == utils::rgb32_layout::argb;
+
+		for (u32 row = row_begin; row < row_end; row++)
+		{
+			const u8* const y = src.y + usz{row} * src.y_pitch;
+			const u8* const u = src.u + usz{row / 2} * src.uv_pitch;
+			const u8* const v = src.v + usz{row / 2} * src.uv_pitch;
+			u8* const out = dst + usz{row} * dst_pitch;
+
+			u32 x = 0;
+
+#if defined(ARCH_X64)
+			if (s_use_avx2)
+			{
+				x = convert_row_avx2(y, u, v, out, width, c, argb, params.alpha);
+			}
+#endif
+
+			x += convert_row_v128(y + x, u + x / 2, v + x / 2, out + x * 4, width - x, c, argb, params.alpha);
+
+			convert_row_scalar(y, u, v, out, x, width, c, get_order(params.layout), params.alpha);
+		}
+	}
+}
+
+namespace utils
+{
+	void convert_yuv420_to_rgb32(const yuv420_planes& src, u8* dst, u32 dst_pitch, u32 width, u32 height, const yuv_to_rgb32_params& params, u32 threads)
+	{
+		const yuv_coefs coefs = make_coefs(params);
+
+		// Rows per slice, even so that slices don't share chroma rows
+		constexpr u32 slice_rows = 16;
+		const u32 slice_count = utils::aligned_div(height, slice_rows);
+
+		threads = std::min(threads, slice_count / 4);
+
+		if (threads <= 1)
+		{
+			convert_rows(src, dst, dst_pitch, width, 0, height, coefs, params);
+			return;
+		}
+
+		atomic_t<u32> next_slice = 0;
+
+		const auto worker = [&]()
+		{
+			for (u32 slice; (slice = next_slice++) < slice_count;)
+			{
+				convert_rows(src, dst, dst_pitch, width, slice * slice_rows, std::min(height, (slice + 1) * slice_rows), coefs, params);
+			}
+		};
+
+		named_thread_group workers("YUV Converter "sv, threads - 1, [&]()
+		{
+			worker();
+		});
+
+		worker();
+		workers.join();
+	}
+
+	void convert_yuv420_to_rgb32_ref(const yuv420_planes& src, u8* dst, u32 dst_pitch, u32 width, u32 row_begin, u32 row_end, const yuv_to_rgb32_params& params)
+	{
+		const yuv_coefs coefs = make_coefs(params);
+
+		for (u32 row = row_begin; row < row_end; row++)
+		{
+			const u8* const u = src.u + usz{row / 2} * src.uv_pitch;
+			const u8* const v = src.v + usz{row / 2} * src.uv_pitch;
+			convert_row_scalar(src.y + usz{row} * src.y_pitch, u, v, dst + usz{row} * dst_pitch, 0, width, coefs, get_order(params.layout), params.alpha);
+		}
+	}
+}
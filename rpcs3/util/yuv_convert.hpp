@@ -0,0 +1,43 @@
+#pragma once
+
+#include "util/types.hpp"
+
+namespace utils
+{
+	enum class yuv_color_matrix : u8
+	{
+		bt601,
+		bt709,
+	};
+
+	enum class rgb32_layout : u8
+	{
+		argb, // Bytes in memory: A, R, G, B
+		rgba, // Bytes in memory: R, G, B, A
+	};
+
+	// Planar YUV 4:2:0 source, chroma planes have (width + 1) / 2 samples per row
+	struct yuv420_planes
+	{
+		const u8* y;
+		const u8* u;
+		const u8* v;
+		u32 y_pitch;
+		u32 uv_pitch;
+	};
+
+	struct yuv_to_rgb32_params
+	{
+		yuv_color_matrix matrix = yuv_color_matrix::bt601;
+		bool full_range = false; // JPEG range (0..255) instead of broadcast range (16..235)
+		rgb32_layout layout = rgb32_layout::rgba;
+		u8 alpha = 0xff; // Constant alpha written to every pixel
+	};
+
+	// Convert YUV420P to interleaved 32-bit RGB, writing directly into dst with the given pitch.
+	// Rows are split into slices converted on up to 'threads' threads (at least 64 rows per thread).
+	void convert_yuv420_to_rgb32(const yuv420_planes& src, u8* dst, u32 dst_pitch, u32 width, u32 height, const yuv_to_rgb32_params& params, u32 threads = 1);
+
+	// Scalar reference of the above, converts rows [row_begin, row_end)
+	void convert_yuv420_to_rgb32_ref(const yuv420_planes& src, u8* dst, u32 dst_pitch, u32 width, u32 row_begin, u32 row_end, const yuv_to_rgb32_params& params);
+}